@@ -18,6 +18,7 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "allocator/Allocator.h"
 
@@ -278,3 +279,77 @@ void AllocatorLoadBalanceTest(Json::Value _settings) {
   delete[] clientGrantCounts;
   delete alloc;
 }
+
+void AllocatorEquivalenceTest(Json::Value _settings1, Json::Value _settings2) {
+  const u64 kSeed = 123;
+  std::vector<u32> sizes = {1, 2, 5, 16, 63, 64, 65, 100};
+  for (u32 C : sizes) {
+    for (u32 R : sizes) {
+      TestSetup testSetup(1, 1, 1, kSeed);
+
+      // printf("C=%u R=%u\n", C, R);
+      bool* request1 = new bool[C * R];
+      bool* request2 = new bool[C * R];
+      u64* metadata = new u64[C * R];
+      bool* grant1 = new bool[C * R];
+      bool* grant2 = new bool[C * R];
+
+      // create the allocators from the same random state
+      gSim->rnd.seed(kSeed);
+      Allocator* alloc1 = Allocator::create(
+          "Alloc1", nullptr, C, R, _settings1);
+      gSim->rnd.seed(kSeed);
+      Allocator* alloc2 = Allocator::create(
+          "Alloc2", nullptr, C, R, _settings2);
+
+      // map I/O to the allocators
+      for (u32 c = 0; c < C; c++) {
+        for (u32 r = 0; r < R; r++) {
+          u64 idx = AllocatorIndex(C, c, r);
+          alloc1->setRequest(c, r, &request1[idx]);
+          alloc1->setMetadata(c, r, &metadata[idx]);
+          alloc1->setGrant(c, r, &grant1[idx]);
+          alloc2->setRequest(c, r, &request2[idx]);
+          alloc2->setMetadata(c, r, &metadata[idx]);
+          alloc2->setGrant(c, r, &grant2[idx]);
+        }
+      }
+
+      // run the test numerous times
+      for (u32 run = 0; run < 100; run++) {
+        // randomize the inputs, clear the grants
+        for (u32 c = 0; c < C; c++) {
+          for (u32 r = 0; r < R; r++) {
+            u64 idx = AllocatorIndex(C, c, r);
+            metadata[idx] = 10000 + c;
+            request1[idx] = gSim->rnd.nextBool();
+            request2[idx] = request1[idx];
+            grant1[idx] = false;
+            grant2[idx] = false;
+          }
+        }
+
+        // allocate
+        alloc1->allocate();
+        alloc2->allocate();
+
+        // verify the grants are identical
+        for (u32 c = 0; c < C; c++) {
+          for (u32 r = 0; r < R; r++) {
+            u64 idx = AllocatorIndex(C, c, r);
+            ASSERT_EQ(grant1[idx], grant2[idx]);
+          }
+        }
+      }
+
+      // cleanup
+      delete[] request1;
+      delete[] request2;
+      delete[] metadata;
+      delete[] grant1;
+      delete[] grant2;
+      delete alloc1;
+      delete alloc2;
+    }
+  }
+}
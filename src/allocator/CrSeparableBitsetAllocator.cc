@@ -0,0 +1,152 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "allocator/CrSeparableBitsetAllocator.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <cassert>
+
+CrSeparableBitsetAllocator::CrSeparableBitsetAllocator(
+    const std::string& _name, const Component* _parent,
+    u32 _numClients, u32 _numResources, Json::Value _settings)
+    : Allocator(_name, _parent, _numClients, _numResources, _settings) {
+  // the round-robin search is equivalent to the lslp arbiter
+  if (_settings["client_arbiter"]["type"].asString() != "lslp" ||
+      _settings["resource_arbiter"]["type"].asString() != "lslp") {
+    fprintf(stderr, "cr_separable_bitset only supports lslp arbiters\n");
+    assert(false);
+  }
+
+  // pointer arrays
+  requests_ = new bool*[numClients_ * numResources_];
+  grants_ = new bool*[numClients_ * numResources_];
+
+  // packed request and intermediate bits
+  requestBits_.resize(numClients_, numResources_);
+  intermediateBits_.resize(numResources_, numClients_);
+
+  // initialize the priorities the same way the lslp arbiters do
+  clientPriorities_.resize(numClients_);
+  clientNextPriorities_.resize(numClients_);
+  for (u32 c = 0; c < numClients_; c++) {
+    clientNextPriorities_[c] = gSim->rnd.nextU64(0, numResources_ - 1);
+    clientPriorities_[c] = clientNextPriorities_[c];
+  }
+  resourcePriorities_.resize(numResources_);
+  resourceNextPriorities_.resize(numResources_);
+  for (u32 r = 0; r < numResources_; r++) {
+    resourceNextPriorities_[r] = gSim->rnd.nextU64(0, numClients_ - 1);
+    resourcePriorities_[r] = resourceNextPriorities_[r];
+  }
+
+  // parse settings
+  iterations_ = _settings["iterations"].asUInt();
+  assert(iterations_ > 0);
+  slipLatch_ = _settings["slip_latch"].asBool();
+}
+
+CrSeparableBitsetAllocator::~CrSeparableBitsetAllocator() {
+  delete[] requests_;
+  delete[] grants_;
+}
+
+void CrSeparableBitsetAllocator::setRequest(u32 _client, u32 _resource,
+                                            bool* _request) {
+  requests_[index(_client, _resource)] = _request;
+}
+
+void CrSeparableBitsetAllocator::setMetadata(u32 _client, u32 _resource,
+                                             u64* _metadata) {
+  // metadata is not used by round-robin arbitration
+}
+
+void CrSeparableBitsetAllocator::setGrant(u32 _client, u32 _resource,
+                                          bool* _grant) {
+  grants_[index(_client, _resource)] = _grant;
+}
+
+void CrSeparableBitsetAllocator::allocate() {
+  // pack the requests
+  requestBits_.clear();
+  for (u32 c = 0; c < numClients_; c++) {
+    for (u32 r = 0; r < numResources_; r++) {
+      if (*requests_[index(c, r)]) {
+        requestBits_.set(c, r);
+      }
+    }
+  }
+
+  for (u32 remaining = iterations_; remaining > 0; remaining--) {
+    // clear the intermediate stage
+    intermediateBits_.clear();
+
+    // run the client arbiters
+    bool anyIntermediate = false;
+    for (u32 c = 0; c < numClients_; c++) {
+      u32 winningResource = requestBits_.rowNext(c, clientPriorities_[c]);
+      if (winningResource != U32_MAX) {
+        anyIntermediate = true;
+        intermediateBits_.set(winningResource, c);
+        clientNextPriorities_[c] = (winningResource + 1) % numResources_;
+      }
+
+      // perform arbiter state latching
+      if (!slipLatch_) {
+        // regular latch always algorithm
+        clientPriorities_[c] = clientNextPriorities_[c];
+      }
+    }
+
+    // without any intermediate grants the remaining iterations are idle
+    if (!anyIntermediate) {
+      break;
+    }
+
+    // run the resource arbiters
+    for (u32 r = 0; r < numResources_; r++) {
+      u32 winningClient = intermediateBits_.rowNext(
+          r, resourcePriorities_[r]);
+      if (winningClient != U32_MAX) {
+        *grants_[index(winningClient, r)] = true;
+        resourceNextPriorities_[r] = (winningClient + 1) % numClients_;
+
+        // remove the requests from this client
+        requestBits_.clearRow(winningClient);
+        // remove the requests for this resource
+        requestBits_.clearColumn(r);
+      }
+
+      // perform arbiter state latching
+      if (slipLatch_) {
+        // slip latching (iSLIP algorithm)
+        if (winningClient != U32_MAX) {
+          resourcePriorities_[r] = resourceNextPriorities_[r];
+          clientPriorities_[winningClient] =
+              clientNextPriorities_[winningClient];
+        }
+      } else {
+        // regular latch always algorithm
+        resourcePriorities_[r] = resourceNextPriorities_[r];
+      }
+    }
+  }
+}
+
+u64 CrSeparableBitsetAllocator::index(u64 _client, u64 _resource) const {
+  return (numResources_ * _client) + _resource;
+}
+
+registerWithObjectFactory("cr_separable_bitset", Allocator,
+                          CrSeparableBitsetAllocator, ALLOCATOR_ARGS);
@@ -0,0 +1,83 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "allocator/CrSeparableBitsetAllocator.h"
+
+#include <json/json.h>
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include "settings/settings.h"
+
+#include "allocator/Allocator_TEST.h"
+
+static void verify(u32 _numClients, u32 _numResources, const bool* _request,
+                   const u64* _metadata, const bool* _grant) {
+  // each client and each resource is granted at most once
+  for (u32 c = 0; c < _numClients; c++) {
+    u32 grants = 0;
+    for (u32 r = 0; r < _numResources; r++) {
+      if (_grant[AllocatorIndex(_numClients, c, r)]) {
+        grants++;
+      }
+    }
+    ASSERT_LE(grants, 1u);
+  }
+  for (u32 r = 0; r < _numResources; r++) {
+    u32 grants = 0;
+    for (u32 c = 0; c < _numClients; c++) {
+      if (_grant[AllocatorIndex(_numClients, c, r)]) {
+        grants++;
+      }
+    }
+    ASSERT_LE(grants, 1u);
+  }
+}
+
+TEST(CrSeparableBitsetAllocator, lslp) {
+  // create the allocator settings
+  Json::Value arbSettings;
+  arbSettings["type"] = "lslp";
+  Json::Value allocSettings;
+  allocSettings["resource_arbiter"] = arbSettings;
+  allocSettings["client_arbiter"] = arbSettings;
+  allocSettings["iterations"] = 3;
+  allocSettings["slip_latch"] = true;
+  allocSettings["type"] = "cr_separable_bitset";
+
+  // test
+  AllocatorTest(allocSettings, verify, false);
+  AllocatorLoadBalanceTest(allocSettings);
+}
+
+TEST(CrSeparableBitsetAllocator, equivalence) {
+  for (u32 iterations = 1; iterations <= 3; iterations++) {
+    for (bool slipLatch : {false, true}) {
+      // create the allocator settings
+      Json::Value arbSettings;
+      arbSettings["type"] = "lslp";
+      Json::Value allocSettings;
+      allocSettings["resource_arbiter"] = arbSettings;
+      allocSettings["client_arbiter"] = arbSettings;
+      allocSettings["iterations"] = iterations;
+      allocSettings["slip_latch"] = slipLatch;
+      allocSettings["type"] = "cr_separable";
+      Json::Value bitsetSettings = allocSettings;
+      bitsetSettings["type"] = "cr_separable_bitset";
+
+      // test
+      AllocatorEquivalenceTest(allocSettings, bitsetSettings);
+    }
+  }
+}
@@ -0,0 +1,348 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "allocator/MaximumMatchingAllocator.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+// returns the mask of bits within word '_word' that are at or after '_start'
+//  for the first pass, and before '_start' for the second pass
+static u64 passMask(u32 _word, u32 _start, u32 _pass) {
+  u32 low = _word * 64;
+  u64 mask;
+  if (_start <= low) {
+    mask = U64_MAX;
+  } else if (_start >= low + 64) {
+    mask = 0;
+  } else {
+    mask = U64_MAX << (_start - low);
+  }
+  return (_pass == 0) ? mask : ~mask;
+}
+
+MaximumMatchingAllocator::MaximumMatchingAllocator(
+    const std::string& _name, const Component* _parent,
+    u32 _numClients, u32 _numResources, Json::Value _settings)
+    : Allocator(_name, _parent, _numClients, _numResources, _settings),
+      weighted_(_settings["weighted"].asBool()),
+      greater_(_settings["greater"].asBool()) {
+  if (weighted_) {
+    assert(!_settings["greater"].isNull());
+  }
+
+  // pointer arrays
+  requests_ = new bool*[numClients_ * numResources_];
+  metadatas_ = new u64*[numClients_ * numResources_];
+  grants_ = new bool*[numClients_ * numResources_];
+
+  // packed request bits
+  requestBits_.resize(numClients_, numResources_);
+  visitedResources_.resize(1, numResources_);
+
+  // matching state
+  clientMatch_.resize(numClients_, U32_MAX);
+  resourceMatch_.resize(numResources_, U32_MAX);
+  distance_.resize(numClients_, U32_MAX);
+  queue_.reserve(numClients_);
+
+  if (weighted_) {
+    u32 n = std::min(numClients_, numResources_);
+    u32 m = std::max(numClients_, numResources_);
+    costs_.resize((u64)(n + 1) * (m + 1), 0);
+    rowPotentials_.resize(n + 1, 0);
+    colPotentials_.resize(m + 1, 0);
+    minSlack_.resize(m + 1, 0);
+    colMatch_.resize(m + 1, 0);
+    colWay_.resize(m + 1, 0);
+    colUsed_.resize(m + 1, false);
+  }
+
+  clientStart_ = 0;
+  resourceStart_ = 0;
+}
+
+MaximumMatchingAllocator::~MaximumMatchingAllocator() {
+  delete[] requests_;
+  delete[] metadatas_;
+  delete[] grants_;
+}
+
+void MaximumMatchingAllocator::setRequest(u32 _client, u32 _resource,
+                                          bool* _request) {
+  requests_[index(_client, _resource)] = _request;
+}
+
+void MaximumMatchingAllocator::setMetadata(u32 _client, u32 _resource,
+                                           u64* _metadata) {
+  metadatas_[index(_client, _resource)] = _metadata;
+}
+
+void MaximumMatchingAllocator::setGrant(u32 _client, u32 _resource,
+                                        bool* _grant) {
+  grants_[index(_client, _resource)] = _grant;
+}
+
+void MaximumMatchingAllocator::allocate() {
+  // pack the requests
+  requestBits_.clear();
+  bool any = false;
+  for (u32 c = 0; c < numClients_; c++) {
+    for (u32 r = 0; r < numResources_; r++) {
+      if (*requests_[index(c, r)]) {
+        requestBits_.set(c, r);
+        any = true;
+      }
+    }
+  }
+  if (!any) {
+    return;
+  }
+
+  // randomize the search order
+  clientStart_ = gSim->rnd.nextU64(0, numClients_ - 1);
+  resourceStart_ = gSim->rnd.nextU64(0, numResources_ - 1);
+
+  if (weighted_) {
+    weightedMatching();
+  } else {
+    cardinalityMatching();
+  }
+}
+
+void MaximumMatchingAllocator::cardinalityMatching() {
+  // start with an empty matching
+  std::fill(clientMatch_.begin(), clientMatch_.end(), U32_MAX);
+  std::fill(resourceMatch_.begin(), resourceMatch_.end(), U32_MAX);
+
+  // each phase augments along a maximal set of shortest augmenting paths
+  while (bfs()) {
+    visitedResources_.clear();
+    for (u32 idx = 0; idx < numClients_; idx++) {
+      u32 client = (clientStart_ + idx) % numClients_;
+      if (clientMatch_[client] == U32_MAX) {
+        dfs(client);
+      }
+    }
+  }
+
+  // deliver the grants
+  for (u32 c = 0; c < numClients_; c++) {
+    if (clientMatch_[c] != U32_MAX) {
+      *grants_[index(c, clientMatch_[c])] = true;
+    }
+  }
+}
+
+bool MaximumMatchingAllocator::bfs() {
+  // free clients form the first layer
+  queue_.clear();
+  for (u32 idx = 0; idx < numClients_; idx++) {
+    u32 client = (clientStart_ + idx) % numClients_;
+    if (clientMatch_[client] == U32_MAX) {
+      distance_[client] = 0;
+      queue_.push_back(client);
+    } else {
+      distance_[client] = U32_MAX;
+    }
+  }
+
+  // a matched client is only reachable through its own resource, therefore
+  //  each resource only needs to be explored once
+  visitedResources_.clear();
+  u64* visited = visitedResources_.row(0);
+  const u32 words = requestBits_.rowWords();
+  u32 limit = U32_MAX;
+  for (u32 head = 0; head < queue_.size(); head++) {
+    u32 client = queue_[head];
+    if (distance_[client] >= limit) {
+      break;
+    }
+    const u64* requests = requestBits_.row(client);
+    for (u32 w = 0; w < words; w++) {
+      u64 unexplored = requests[w] & ~visited[w];
+      visited[w] |= unexplored;
+      while (unexplored != 0) {
+        u32 resource = (w * 64) + __builtin_ctzll(unexplored);
+        unexplored &= unexplored - 1;
+        u32 owner = resourceMatch_[resource];
+        if (owner == U32_MAX) {
+          // an augmenting path ends here
+          limit = distance_[client] + 1;
+        } else if (distance_[owner] == U32_MAX) {
+          distance_[owner] = distance_[client] + 1;
+          queue_.push_back(owner);
+        }
+      }
+    }
+  }
+  return limit != U32_MAX;
+}
+
+bool MaximumMatchingAllocator::dfs(u32 _client) {
+  const u64* requests = requestBits_.row(_client);
+  u64* visited = visitedResources_.row(0);
+  const u32 words = requestBits_.rowWords();
+
+  // scan the requested resources starting at 'resourceStart_', wrapping around
+  for (u32 pass = 0; pass < 2; pass++) {
+    for (u32 w = 0; w < words; w++) {
+      u64 word = requests[w] & passMask(w, resourceStart_, pass);
+      while (word != 0) {
+        u32 resource = (w * 64) + __builtin_ctzll(word);
+        word &= word - 1;
+
+        // only follow edges of the layered graph, each resource is used at
+        //  most once per phase
+        if (visitedResources_.test(0, resource)) {
+          continue;
+        }
+        u32 owner = resourceMatch_[resource];
+        if ((owner != U32_MAX) &&
+            (distance_[owner] != distance_[_client] + 1)) {
+          continue;
+        }
+        visited[w] |= (u64)1 << (resource % 64);
+        if ((owner == U32_MAX) || dfs(owner)) {
+          clientMatch_[_client] = resource;
+          resourceMatch_[resource] = _client;
+          return true;
+        }
+      }
+    }
+  }
+
+  // this client is a dead end for the rest of this phase
+  distance_[_client] = U32_MAX;
+  return false;
+}
+
+void MaximumMatchingAllocator::weightedMatching() {
+  // the rows of the cost matrix are the smaller side
+  const bool clientRows = numClients_ <= numResources_;
+  const u32 n = clientRows ? numClients_ : numResources_;
+  const u32 m = clientRows ? numResources_ : numClients_;
+
+  // find the metadata range of the requests
+  u64 minMeta = U64_MAX;
+  u64 maxMeta = 0;
+  for (u32 c = 0; c < numClients_; c++) {
+    for (u32 r = 0; r < numResources_; r++) {
+      if (requestBits_.test(c, r)) {
+        u64 meta = *metadatas_[index(c, r)];
+        minMeta = std::min(minMeta, meta);
+        maxMeta = std::max(maxMeta, meta);
+      }
+    }
+  }
+  u64 span = maxMeta - minMeta;
+
+  // a missing request costs more than any set of real requests so the
+  //  number of real requests matched is maximized first
+  assert((f64)n * (f64)n * (f64)(span + 1) < 1e18);
+  const s64 missing = (s64)n * (s64)(span + 1) + 1;
+
+  // fill the 1-based cost matrix using the randomized order
+  for (u32 i = 1; i <= n; i++) {
+    for (u32 j = 1; j <= m; j++) {
+      u32 c, r;
+      if (clientRows) {
+        c = (clientStart_ + i - 1) % numClients_;
+        r = (resourceStart_ + j - 1) % numResources_;
+      } else {
+        c = (clientStart_ + j - 1) % numClients_;
+        r = (resourceStart_ + i - 1) % numResources_;
+      }
+      s64 cost = missing;
+      if (requestBits_.test(c, r)) {
+        u64 meta = *metadatas_[index(c, r)];
+        cost = greater_ ? (s64)(maxMeta - meta) : (s64)(meta - minMeta);
+      }
+      costs_[(u64)i * (m + 1) + j] = cost;
+    }
+  }
+
+  // Hungarian algorithm (shortest augmenting paths with potentials)
+  const s64 infinity = std::numeric_limits<s64>::max();
+  std::fill(rowPotentials_.begin(), rowPotentials_.end(), 0);
+  std::fill(colPotentials_.begin(), colPotentials_.end(), 0);
+  std::fill(colMatch_.begin(), colMatch_.end(), 0);
+  std::fill(colWay_.begin(), colWay_.end(), 0);
+  for (u32 i = 1; i <= n; i++) {
+    colMatch_[0] = i;
+    u32 j0 = 0;
+    std::fill(minSlack_.begin(), minSlack_.end(), infinity);
+    std::fill(colUsed_.begin(), colUsed_.end(), false);
+    do {
+      colUsed_[j0] = true;
+      u32 i0 = colMatch_[j0];
+      s64 delta = infinity;
+      u32 j1 = 0;
+      for (u32 j = 1; j <= m; j++) {
+        if (!colUsed_[j]) {
+          s64 cur = costs_[(u64)i0 * (m + 1) + j] - rowPotentials_[i0] -
+              colPotentials_[j];
+          if (cur < minSlack_[j]) {
+            minSlack_[j] = cur;
+            colWay_[j] = j0;
+          }
+          if (minSlack_[j] < delta) {
+            delta = minSlack_[j];
+            j1 = j;
+          }
+        }
+      }
+      for (u32 j = 0; j <= m; j++) {
+        if (colUsed_[j]) {
+          rowPotentials_[colMatch_[j]] += delta;
+          colPotentials_[j] -= delta;
+        } else {
+          minSlack_[j] -= delta;
+        }
+      }
+      j0 = j1;
+    } while (colMatch_[j0] != 0);
+    do {
+      u32 j1 = colWay_[j0];
+      colMatch_[j0] = colMatch_[j1];
+      j0 = j1;
+    } while (j0 != 0);
+  }
+
+  // deliver the grants for real requests
+  for (u32 j = 1; j <= m; j++) {
+    u32 i = colMatch_[j];
+    if (i != 0 && costs_[(u64)i * (m + 1) + j] != missing) {
+      u32 c, r;
+      if (clientRows) {
+        c = (clientStart_ + i - 1) % numClients_;
+        r = (resourceStart_ + j - 1) % numResources_;
+      } else {
+        c = (clientStart_ + j - 1) % numClients_;
+        r = (resourceStart_ + i - 1) % numResources_;
+      }
+      *grants_[index(c, r)] = true;
+    }
+  }
+}
+
+u64 MaximumMatchingAllocator::index(u64 _client, u64 _resource) const {
+  return (numClients_ * _resource) + _client;
+}
+
+registerWithObjectFactory("maximum_matching", Allocator,
+                          MaximumMatchingAllocator, ALLOCATOR_ARGS);
@@ -0,0 +1,97 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ALLOCATOR_MAXIMUMMATCHINGALLOCATOR_H_
+#define ALLOCATOR_MAXIMUMMATCHINGALLOCATOR_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+#include "allocator/Allocator.h"
+#include "event/Component.h"
+#include "util/BitMatrix.h"
+
+/*
+ * This is a reference allocator that always produces a maximum cardinality
+ *  matching of clients to resources. It is not a realistic hardware design,
+ *  it exists to measure how far realistic allocators are from the ideal.
+ *
+ * The default mode uses the Hopcroft-Karp algorithm over packed request rows
+ *  so that explored resources are masked out a word at a time. The client
+ *  order and resource search position are randomized every allocation so
+ *  that no client or resource is systematically favored.
+ *
+ * When "weighted" is true, the metadata is used as the weight of each
+ *  request. Among all maximum cardinality matchings the one with the largest
+ *  ("greater" is true) or smallest ("greater" is false) total metadata is
+ *  chosen using the Hungarian algorithm. This mode is O(n^2 m) where n and m
+ *  are the smaller and larger of the client and resource counts.
+ */
+class MaximumMatchingAllocator : public Allocator {
+ public:
+  MaximumMatchingAllocator(const std::string& _name, const Component* _parent,
+                           u32 _numClients, u32 _numResources,
+                           Json::Value _settings);
+  ~MaximumMatchingAllocator();
+
+  void setRequest(u32 _client, u32 _resource,
+                  bool* _request) override;
+  void setMetadata(u32 _client, u32 _resource,
+                   u64* _metadata) override;
+  void setGrant(u32 _client, u32 _resource, bool* _grant) override;
+
+  void allocate() override;
+
+ private:
+  void cardinalityMatching();
+  bool bfs();
+  bool dfs(u32 _client);
+  void weightedMatching();
+
+  bool** requests_;
+  u64** metadatas_;
+  bool** grants_;
+
+  const bool weighted_;
+  const bool greater_;
+
+  BitMatrix requestBits_;  // [client][resource]
+  BitMatrix visitedResources_;
+
+  // per allocation randomization
+  u32 clientStart_;
+  u32 resourceStart_;
+
+  // Hopcroft-Karp state
+  std::vector<u32> clientMatch_;
+  std::vector<u32> resourceMatch_;
+  std::vector<u32> distance_;
+  std::vector<u32> queue_;
+
+  // Hungarian algorithm state
+  std::vector<s64> costs_;
+  std::vector<s64> rowPotentials_;
+  std::vector<s64> colPotentials_;
+  std::vector<s64> minSlack_;
+  std::vector<u32> colMatch_;
+  std::vector<u32> colWay_;
+  std::vector<bool> colUsed_;
+
+  u64 index(u64 _client, u64 _resource) const;
+};
+
+#endif  // ALLOCATOR_MAXIMUMMATCHINGALLOCATOR_H_
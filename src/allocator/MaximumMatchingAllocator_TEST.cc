@@ -0,0 +1,209 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "allocator/MaximumMatchingAllocator.h"
+
+#include <json/json.h>
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "settings/settings.h"
+
+#include "allocator/Allocator.h"
+#include "allocator/Allocator_TEST.h"
+#include "test/TestSetup_TEST.h"
+
+// simple augmenting path search used as a reference
+static bool augment(u32 _numClients, u32 _numResources, const bool* _request,
+                    u32 _client, std::vector<bool>* _seen,
+                    std::vector<u32>* _resourceMatch) {
+  for (u32 r = 0; r < _numResources; r++) {
+    if (_request[AllocatorIndex(_numClients, _client, r)] && !_seen->at(r)) {
+      _seen->at(r) = true;
+      if (_resourceMatch->at(r) == U32_MAX ||
+          augment(_numClients, _numResources, _request,
+                  _resourceMatch->at(r), _seen, _resourceMatch)) {
+        _resourceMatch->at(r) = _client;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static u32 maximumMatchingSize(u32 _numClients, u32 _numResources,
+                               const bool* _request) {
+  std::vector<u32> resourceMatch(_numResources, U32_MAX);
+  u32 size = 0;
+  for (u32 c = 0; c < _numClients; c++) {
+    std::vector<bool> seen(_numResources, false);
+    if (augment(_numClients, _numResources, _request, c, &seen,
+                &resourceMatch)) {
+      size++;
+    }
+  }
+  return size;
+}
+
+static void verify(u32 _numClients, u32 _numResources, const bool* _request,
+                   const u64* _metadata, const bool* _grant) {
+  // each client and each resource is granted at most once
+  std::vector<bool> clientGranted(_numClients, false);
+  std::vector<bool> resourceGranted(_numResources, false);
+  u32 grants = 0;
+  for (u32 c = 0; c < _numClients; c++) {
+    for (u32 r = 0; r < _numResources; r++) {
+      if (_grant[AllocatorIndex(_numClients, c, r)]) {
+        ASSERT_FALSE(clientGranted[c]);
+        ASSERT_FALSE(resourceGranted[r]);
+        clientGranted[c] = true;
+        resourceGranted[r] = true;
+        grants++;
+      }
+    }
+  }
+
+  // the matching is maximum
+  ASSERT_EQ(grants, maximumMatchingSize(_numClients, _numResources,
+                                        _request));
+}
+
+TEST(MaximumMatchingAllocator, cardinality) {
+  // create the allocator settings
+  Json::Value allocSettings;
+  allocSettings["type"] = "maximum_matching";
+  allocSettings["weighted"] = false;
+
+  // test
+  AllocatorTest(allocSettings, verify, false);
+  AllocatorTest(allocSettings, verify, true);
+  AllocatorLoadBalanceTest(allocSettings);
+}
+
+TEST(MaximumMatchingAllocator, weighted) {
+  for (bool greater : {false, true}) {
+    // create the allocator settings
+    Json::Value allocSettings;
+    allocSettings["type"] = "maximum_matching";
+    allocSettings["weighted"] = true;
+    allocSettings["greater"] = greater;
+
+    // test
+    AllocatorTest(allocSettings, verify, false);
+  }
+}
+
+// finds the best total weight of all maximum cardinality matchings
+static void bruteForce(u32 _numClients, u32 _numResources,
+                       const bool* _request, const u64* _metadata,
+                       bool _greater, u32 _client, std::vector<bool>* _used,
+                       u32 _size, u64 _weight, u32* _bestSize,
+                       u64* _bestWeight) {
+  if (_client == _numClients) {
+    bool better = (_size > *_bestSize) ||
+        ((_size == *_bestSize) &&
+         (_greater ? (_weight > *_bestWeight) : (_weight < *_bestWeight)));
+    if (better) {
+      *_bestSize = _size;
+      *_bestWeight = _weight;
+    }
+    return;
+  }
+
+  // leave this client unmatched
+  bruteForce(_numClients, _numResources, _request, _metadata, _greater,
+             _client + 1, _used, _size, _weight, _bestSize, _bestWeight);
+
+  // match this client to each available resource
+  for (u32 r = 0; r < _numResources; r++) {
+    u64 idx = AllocatorIndex(_numClients, _client, r);
+    if (_request[idx] && !_used->at(r)) {
+      _used->at(r) = true;
+      bruteForce(_numClients, _numResources, _request, _metadata, _greater,
+                 _client + 1, _used, _size + 1, _weight + _metadata[idx],
+                 _bestSize, _bestWeight);
+      _used->at(r) = false;
+    }
+  }
+}
+
+TEST(MaximumMatchingAllocator, weightOptimal) {
+  for (bool greater : {false, true}) {
+    Json::Value allocSettings;
+    allocSettings["type"] = "maximum_matching";
+    allocSettings["weighted"] = true;
+    allocSettings["greater"] = greater;
+
+    for (u32 C = 1; C <= 6; C++) {
+      for (u32 R = 1; R <= 6; R++) {
+        TestSetup testSetup(1, 1, 1, 123);
+        bool* request = new bool[C * R];
+        u64* metadata = new u64[C * R];
+        bool* grant = new bool[C * R];
+
+        Allocator* alloc = Allocator::create(
+            "Alloc", nullptr, C, R, allocSettings);
+        for (u32 c = 0; c < C; c++) {
+          for (u32 r = 0; r < R; r++) {
+            u64 idx = AllocatorIndex(C, c, r);
+            alloc->setRequest(c, r, &request[idx]);
+            alloc->setMetadata(c, r, &metadata[idx]);
+            alloc->setGrant(c, r, &grant[idx]);
+          }
+        }
+
+        for (u32 run = 0; run < 50; run++) {
+          for (u32 idx = 0; idx < C * R; idx++) {
+            request[idx] = gSim->rnd.nextBool();
+            metadata[idx] = gSim->rnd.nextU64(1000, 1020);
+            grant[idx] = false;
+          }
+
+          alloc->allocate();
+
+          // compute the granted size and weight
+          u32 size = 0;
+          u64 weight = 0;
+          for (u32 idx = 0; idx < C * R; idx++) {
+            if (grant[idx]) {
+              ASSERT_TRUE(request[idx]);
+              size++;
+              weight += metadata[idx];
+            }
+          }
+
+          // compare against the brute force answer
+          std::vector<bool> used(R, false);
+          u32 bestSize = 0;
+          u64 bestWeight = greater ? 0 : U64_MAX;
+          bruteForce(C, R, request, metadata, greater, 0, &used, 0, 0,
+                     &bestSize, &bestWeight);
+          if (bestSize == 0) {
+            bestWeight = 0;
+          }
+          ASSERT_EQ(size, bestSize);
+          ASSERT_EQ(weight, bestWeight);
+        }
+
+        delete[] request;
+        delete[] metadata;
+        delete[] grant;
+        delete alloc;
+      }
+    }
+  }
+}
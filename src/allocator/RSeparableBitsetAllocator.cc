@@ -0,0 +1,101 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "allocator/RSeparableBitsetAllocator.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <cassert>
+
+RSeparableBitsetAllocator::RSeparableBitsetAllocator(
+    const std::string& _name, const Component* _parent,
+    u32 _numClients, u32 _numResources, Json::Value _settings)
+    : Allocator(_name, _parent, _numClients, _numResources, _settings) {
+  // the round-robin search is equivalent to the lslp arbiter
+  if (_settings["resource_arbiter"]["type"].asString() != "lslp") {
+    fprintf(stderr, "r_separable_bitset only supports lslp arbiters\n");
+    assert(false);
+  }
+
+  // pointer arrays
+  requests_ = new bool*[numClients_ * numResources_];
+  grants_ = new bool*[numClients_ * numResources_];
+
+  // packed request bits
+  requestBits_.resize(numResources_, numClients_);
+
+  // initialize the resource priorities the same way the lslp arbiters do
+  resourcePriorities_.resize(numResources_);
+  resourceNextPriorities_.resize(numResources_);
+  for (u32 r = 0; r < numResources_; r++) {
+    resourceNextPriorities_[r] = gSim->rnd.nextU64(0, numClients_ - 1);
+    resourcePriorities_[r] = resourceNextPriorities_[r];
+  }
+
+  // parse settings
+  slipLatch_ = _settings["slip_latch"].asBool();
+}
+
+RSeparableBitsetAllocator::~RSeparableBitsetAllocator() {
+  delete[] requests_;
+  delete[] grants_;
+}
+
+void RSeparableBitsetAllocator::setRequest(u32 _client, u32 _resource,
+                                           bool* _request) {
+  requests_[index(_client, _resource)] = _request;
+}
+
+void RSeparableBitsetAllocator::setMetadata(u32 _client, u32 _resource,
+                                            u64* _metadata) {
+  // metadata is not used by round-robin arbitration
+}
+
+void RSeparableBitsetAllocator::setGrant(u32 _client, u32 _resource,
+                                         bool* _grant) {
+  grants_[index(_client, _resource)] = _grant;
+}
+
+void RSeparableBitsetAllocator::allocate() {
+  // pack the requests
+  requestBits_.clear();
+  for (u32 r = 0; r < numResources_; r++) {
+    for (u32 c = 0; c < numClients_; c++) {
+      if (*requests_[index(c, r)]) {
+        requestBits_.set(r, c);
+      }
+    }
+  }
+
+  // run the resource arbiters
+  for (u32 r = 0; r < numResources_; r++) {
+    u32 winningClient = requestBits_.rowNext(r, resourcePriorities_[r]);
+    if (winningClient != U32_MAX) {
+      *grants_[index(winningClient, r)] = true;
+      resourceNextPriorities_[r] = (winningClient + 1) % numClients_;
+    }
+
+    // perform arbiter state latching
+    if (!slipLatch_ || winningClient != U32_MAX) {
+      resourcePriorities_[r] = resourceNextPriorities_[r];
+    }
+  }
+}
+
+u64 RSeparableBitsetAllocator::index(u64 _client, u64 _resource) const {
+  return (numClients_ * _resource) + _client;
+}
+
+registerWithObjectFactory("r_separable_bitset", Allocator,
+                          RSeparableBitsetAllocator, ALLOCATOR_ARGS);
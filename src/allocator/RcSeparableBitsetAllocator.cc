@@ -0,0 +1,152 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "allocator/RcSeparableBitsetAllocator.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <cassert>
+
+RcSeparableBitsetAllocator::RcSeparableBitsetAllocator(
+    const std::string& _name, const Component* _parent,
+    u32 _numClients, u32 _numResources, Json::Value _settings)
+    : Allocator(_name, _parent, _numClients, _numResources, _settings) {
+  // the round-robin search is equivalent to the lslp arbiter
+  if (_settings["resource_arbiter"]["type"].asString() != "lslp" ||
+      _settings["client_arbiter"]["type"].asString() != "lslp") {
+    fprintf(stderr, "rc_separable_bitset only supports lslp arbiters\n");
+    assert(false);
+  }
+
+  // pointer arrays
+  requests_ = new bool*[numClients_ * numResources_];
+  grants_ = new bool*[numClients_ * numResources_];
+
+  // packed request and intermediate bits
+  requestBits_.resize(numResources_, numClients_);
+  intermediateBits_.resize(numClients_, numResources_);
+
+  // initialize the priorities the same way the lslp arbiters do
+  resourcePriorities_.resize(numResources_);
+  resourceNextPriorities_.resize(numResources_);
+  for (u32 r = 0; r < numResources_; r++) {
+    resourceNextPriorities_[r] = gSim->rnd.nextU64(0, numClients_ - 1);
+    resourcePriorities_[r] = resourceNextPriorities_[r];
+  }
+  clientPriorities_.resize(numClients_);
+  clientNextPriorities_.resize(numClients_);
+  for (u32 c = 0; c < numClients_; c++) {
+    clientNextPriorities_[c] = gSim->rnd.nextU64(0, numResources_ - 1);
+    clientPriorities_[c] = clientNextPriorities_[c];
+  }
+
+  // parse settings
+  iterations_ = _settings["iterations"].asUInt();
+  assert(iterations_ > 0);
+  slipLatch_ = _settings["slip_latch"].asBool();
+}
+
+RcSeparableBitsetAllocator::~RcSeparableBitsetAllocator() {
+  delete[] requests_;
+  delete[] grants_;
+}
+
+void RcSeparableBitsetAllocator::setRequest(u32 _client, u32 _resource,
+                                            bool* _request) {
+  requests_[index(_client, _resource)] = _request;
+}
+
+void RcSeparableBitsetAllocator::setMetadata(u32 _client, u32 _resource,
+                                             u64* _metadata) {
+  // metadata is not used by round-robin arbitration
+}
+
+void RcSeparableBitsetAllocator::setGrant(u32 _client, u32 _resource,
+                                          bool* _grant) {
+  grants_[index(_client, _resource)] = _grant;
+}
+
+void RcSeparableBitsetAllocator::allocate() {
+  // pack the requests
+  requestBits_.clear();
+  for (u32 r = 0; r < numResources_; r++) {
+    for (u32 c = 0; c < numClients_; c++) {
+      if (*requests_[index(c, r)]) {
+        requestBits_.set(r, c);
+      }
+    }
+  }
+
+  for (u32 remaining = iterations_; remaining > 0; remaining--) {
+    // clear the intermediate stage
+    intermediateBits_.clear();
+
+    // run the resource arbiters
+    bool anyIntermediate = false;
+    for (u32 r = 0; r < numResources_; r++) {
+      u32 winningClient = requestBits_.rowNext(r, resourcePriorities_[r]);
+      if (winningClient != U32_MAX) {
+        anyIntermediate = true;
+        intermediateBits_.set(winningClient, r);
+        resourceNextPriorities_[r] = (winningClient + 1) % numClients_;
+      }
+
+      // perform arbiter state latching
+      if (!slipLatch_) {
+        // regular latch always algorithm
+        resourcePriorities_[r] = resourceNextPriorities_[r];
+      }
+    }
+
+    // without any intermediate grants the remaining iterations are idle
+    if (!anyIntermediate) {
+      break;
+    }
+
+    // run the client arbiters
+    for (u32 c = 0; c < numClients_; c++) {
+      u32 winningResource = intermediateBits_.rowNext(
+          c, clientPriorities_[c]);
+      if (winningResource != U32_MAX) {
+        *grants_[index(c, winningResource)] = true;
+        clientNextPriorities_[c] = (winningResource + 1) % numResources_;
+
+        // remove the requests from this client
+        requestBits_.clearColumn(c);
+        // remove the requests for this resource
+        requestBits_.clearRow(winningResource);
+      }
+
+      // perform arbiter state latching
+      if (slipLatch_) {
+        // slip latching (iSLIP algorithm)
+        if (winningResource != U32_MAX) {
+          clientPriorities_[c] = clientNextPriorities_[c];
+          resourcePriorities_[winningResource] =
+              resourceNextPriorities_[winningResource];
+        }
+      } else {
+        // regular latch always algorithm
+        clientPriorities_[c] = clientNextPriorities_[c];
+      }
+    }
+  }
+}
+
+u64 RcSeparableBitsetAllocator::index(u64 _client, u64 _resource) const {
+  return (numClients_ * _resource) + _client;
+}
+
+registerWithObjectFactory("rc_separable_bitset", Allocator,
+                          RcSeparableBitsetAllocator, ALLOCATOR_ARGS);
@@ -0,0 +1,71 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ALLOCATOR_RCSEPARABLEBITSETALLOCATOR_H_
+#define ALLOCATOR_RCSEPARABLEBITSETALLOCATOR_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+#include "allocator/Allocator.h"
+#include "event/Component.h"
+#include "util/BitMatrix.h"
+
+/*
+ * This is a bit matrix implementation of the RcSeparableAllocator. The
+ *  requests are packed by resource and the intermediate grants are packed by
+ *  client so that each arbiter is a round-robin search over a single row and
+ *  matched clients and resources are removed with row and column masks. It
+ *  produces the same grants as the RcSeparableAllocator configured with
+ *  "lslp" resource and client arbiters. Unlike the RcSeparableAllocator, the
+ *  request inputs are only read, not cleared.
+ */
+class RcSeparableBitsetAllocator : public Allocator {
+ public:
+  RcSeparableBitsetAllocator(const std::string& _name,
+                             const Component* _parent,
+                             u32 _numClients, u32 _numResources,
+                             Json::Value _settings);
+  ~RcSeparableBitsetAllocator();
+
+  void setRequest(u32 _client, u32 _resource,
+                  bool* _request) override;
+  void setMetadata(u32 _client, u32 _resource,
+                   u64* _metadata) override;
+  void setGrant(u32 _client, u32 _resource, bool* _grant) override;
+
+  void allocate() override;
+
+ private:
+  bool** requests_;
+  bool** grants_;
+
+  BitMatrix requestBits_;  // [resource][client]
+  BitMatrix intermediateBits_;  // [client][resource]
+
+  std::vector<u32> resourcePriorities_;
+  std::vector<u32> resourceNextPriorities_;
+  std::vector<u32> clientPriorities_;
+  std::vector<u32> clientNextPriorities_;
+
+  u32 iterations_;
+  bool slipLatch_;  // iSLIP selective priority latching
+
+  u64 index(u64 _client, u64 _resource) const;
+};
+
+#endif  // ALLOCATOR_RCSEPARABLEBITSETALLOCATOR_H_
@@ -0,0 +1,116 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "allocator/WavefrontAllocator.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <algorithm>
+#include <cassert>
+
+WavefrontAllocator::WavefrontAllocator(
+    const std::string& _name, const Component* _parent,
+    u32 _numClients, u32 _numResources, Json::Value _settings)
+    : Allocator(_name, _parent, _numClients, _numResources, _settings),
+      size_(std::max(_numClients, _numResources)) {
+  // pointer arrays
+  requests_ = new bool*[numClients_ * numResources_];
+  grants_ = new bool*[numClients_ * numResources_];
+
+  // packed request bits and availability
+  diagonalBits_.resize(size_, numClients_);
+  freeClients_.resize(1, numClients_);
+  freeResources_.resize(1, numResources_);
+
+  // start at a random diagonal
+  priority_ = gSim->rnd.nextU64(0, size_ - 1);
+}
+
+WavefrontAllocator::~WavefrontAllocator() {
+  delete[] requests_;
+  delete[] grants_;
+}
+
+void WavefrontAllocator::setRequest(u32 _client, u32 _resource,
+                                    bool* _request) {
+  requests_[index(_client, _resource)] = _request;
+}
+
+void WavefrontAllocator::setMetadata(u32 _client, u32 _resource,
+                                     u64* _metadata) {
+  // metadata is not used by wavefront allocation
+}
+
+void WavefrontAllocator::setGrant(u32 _client, u32 _resource, bool* _grant) {
+  grants_[index(_client, _resource)] = _grant;
+}
+
+void WavefrontAllocator::allocate() {
+  // pack the requests by diagonal
+  diagonalBits_.clear();
+  for (u32 r = 0; r < numResources_; r++) {
+    for (u32 c = 0; c < numClients_; c++) {
+      if (*requests_[index(c, r)]) {
+        diagonalBits_.set((c + r) % size_, c);
+      }
+    }
+  }
+
+  // everything starts out free
+  for (u32 c = 0; c < numClients_; c++) {
+    freeClients_.set(0, c);
+  }
+  for (u32 r = 0; r < numResources_; r++) {
+    freeResources_.set(0, r);
+  }
+  u32 remainingClients = numClients_;
+  u32 remainingResources = numResources_;
+
+  // sweep the diagonals starting at the priority diagonal
+  const u32 words = diagonalBits_.rowWords();
+  u64* freeClients = freeClients_.row(0);
+  for (u32 d = 0;
+       d < size_ && remainingClients > 0 && remainingResources > 0; d++) {
+    u32 diagonal = (priority_ + d) % size_;
+    const u64* diagonalBits = diagonalBits_.row(diagonal);
+    for (u32 w = 0; w < words; w++) {
+      // requesting clients that are still free
+      u64 candidates = diagonalBits[w] & freeClients[w];
+      while (candidates != 0) {
+        u32 client = (w * 64) + __builtin_ctzll(candidates);
+        candidates &= candidates - 1;
+
+        // the resource of this cell of the diagonal
+        u32 resource = (diagonal + size_ - client) % size_;
+        if (freeResources_.test(0, resource)) {
+          *grants_[index(client, resource)] = true;
+          freeClients_.clear(0, client);
+          freeResources_.clear(0, resource);
+          remainingClients--;
+          remainingResources--;
+        }
+      }
+    }
+  }
+
+  // rotate the priority diagonal
+  priority_ = (priority_ + 1) % size_;
+}
+
+u64 WavefrontAllocator::index(u64 _client, u64 _resource) const {
+  return (numClients_ * _resource) + _client;
+}
+
+registerWithObjectFactory("wavefront", Allocator, WavefrontAllocator,
+                          ALLOCATOR_ARGS);
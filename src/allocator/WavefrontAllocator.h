@@ -0,0 +1,68 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ALLOCATOR_WAVEFRONTALLOCATOR_H_
+#define ALLOCATOR_WAVEFRONTALLOCATOR_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+
+#include "allocator/Allocator.h"
+#include "event/Component.h"
+#include "util/BitMatrix.h"
+
+/*
+ * This is a wavefront allocator. The request matrix is padded to a square of
+ *  size max(numClients, numResources) and is granted one diagonal at a time
+ *  starting at the priority diagonal. The cells of a diagonal never share a
+ *  client or a resource so each is granted when its client and resource are
+ *  still free. The priority diagonal rotates every allocation. The result is
+ *  always a maximal matching.
+ *
+ * The requests are packed with one row of client bits per diagonal so each
+ *  diagonal is evaluated by masking its row with the free clients.
+ */
+class WavefrontAllocator : public Allocator {
+ public:
+  WavefrontAllocator(const std::string& _name, const Component* _parent,
+                     u32 _numClients, u32 _numResources,
+                     Json::Value _settings);
+  ~WavefrontAllocator();
+
+  void setRequest(u32 _client, u32 _resource,
+                  bool* _request) override;
+  void setMetadata(u32 _client, u32 _resource,
+                   u64* _metadata) override;
+  void setGrant(u32 _client, u32 _resource, bool* _grant) override;
+
+  void allocate() override;
+
+ private:
+  const u32 size_;
+
+  bool** requests_;
+  bool** grants_;
+
+  BitMatrix diagonalBits_;  // [diagonal][client]
+  BitMatrix freeClients_;
+  BitMatrix freeResources_;
+
+  u32 priority_;  // priority diagonal
+
+  u64 index(u64 _client, u64 _resource) const;
+};
+
+#endif  // ALLOCATOR_WAVEFRONTALLOCATOR_H_
@@ -0,0 +1,62 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "allocator/WavefrontAllocator.h"
+
+#include <json/json.h>
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <vector>
+
+#include "settings/settings.h"
+
+#include "allocator/Allocator_TEST.h"
+
+static void verify(u32 _numClients, u32 _numResources, const bool* _request,
+                   const u64* _metadata, const bool* _grant) {
+  // each client and each resource is granted at most once
+  std::vector<bool> clientGranted(_numClients, false);
+  std::vector<bool> resourceGranted(_numResources, false);
+  for (u32 c = 0; c < _numClients; c++) {
+    for (u32 r = 0; r < _numResources; r++) {
+      if (_grant[AllocatorIndex(_numClients, c, r)]) {
+        ASSERT_FALSE(clientGranted[c]);
+        ASSERT_FALSE(resourceGranted[r]);
+        clientGranted[c] = true;
+        resourceGranted[r] = true;
+      }
+    }
+  }
+
+  // the matching is maximal
+  for (u32 c = 0; c < _numClients; c++) {
+    for (u32 r = 0; r < _numResources; r++) {
+      if (_request[AllocatorIndex(_numClients, c, r)]) {
+        ASSERT_TRUE(clientGranted[c] || resourceGranted[r]);
+      }
+    }
+  }
+}
+
+TEST(WavefrontAllocator, basic) {
+  // create the allocator settings
+  Json::Value allocSettings;
+  allocSettings["type"] = "wavefront";
+
+  // test
+  AllocatorTest(allocSettings, verify, false);
+  AllocatorTest(allocSettings, verify, true);
+  AllocatorLoadBalanceTest(allocSettings);
+}
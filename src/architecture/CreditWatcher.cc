@@ -17,3 +17,15 @@
 CreditWatcher::CreditWatcher() {}
 
 CreditWatcher::~CreditWatcher() {}
+
+void CreditWatcher::incrementCredits(u32 _vcIdx, u32 _credits) {
+  for (u32 c = 0; c < _credits; c++) {
+    incrementCredit(_vcIdx);
+  }
+}
+
+void CreditWatcher::decrementCredits(u32 _vcIdx, u32 _credits) {
+  for (u32 c = 0; c < _credits; c++) {
+    decrementCredit(_vcIdx);
+  }
+}
@@ -30,6 +30,11 @@ class CreditWatcher {
   virtual void initCredits(u32 _vcIdx, u32 _credits) = 0;
   virtual void incrementCredit(u32 _vcIdx) = 0;
   virtual void decrementCredit(u32 _vcIdx) = 0;
+
+  // these move several credits of a VC at once, by default they repeat the
+  //  single credit versions
+  virtual void incrementCredits(u32 _vcIdx, u32 _credits);
+  virtual void decrementCredits(u32 _vcIdx, u32 _credits);
 };
 
 #endif  // ARCHITECTURE_CREDITWATCHER_H_
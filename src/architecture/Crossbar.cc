@@ -23,12 +23,17 @@ Crossbar::Crossbar(const std::string& _name, const Component* _parent,
                    Json::Value _settings)
     : Component(_name, _parent), clock_(_clock),
       latency_(_settings["latency"].asUInt()),
-      numInputs_(_numInputs), numOutputs_(_numOutputs) {
+      numInputs_(_numInputs), numOutputs_(_numOutputs), width_(1),
+      numSlots_(latency_ + 1) {
   assert(latency_ > 0);
 
   std::pair<u32, FlitReceiver*> def(U32_MAX, nullptr);
   receivers_.resize(numOutputs_, def);
   nextTime_ = U64_MAX;
+
+  // preallocate the schedule
+  slots_.resize((u64)numSlots_ * numOutputs_, nullptr);
+  occupied_.resize(numSlots_, numOutputs_);
 }
 
 Crossbar::~Crossbar() {}
@@ -47,48 +52,74 @@ void Crossbar::setReceiver(u32 _destId, FlitReceiver* _receiver,
   receivers_.at(_destId).second = _receiver;
 }
 
+void Crossbar::setWidth(u32 _width) {
+  assert(_width > 0);
+  assert(nextTime_ == U64_MAX);
+  width_ = _width;
+  slots_.assign((u64)numSlots_ * numOutputs_ * width_, nullptr);
+  occupied_.resize(numSlots_, numOutputs_ * width_);
+}
+
 void Crossbar::inject(Flit* _flit, u32 _srcId, u32 _destId) {
   // 'srcId' is not being used, but is available for debugging
   assert(_srcId < numInputs_);
 
+  // find the slot of the current cycle
+  u32 slot = gSim->cycle(clock_) % numSlots_;
+
   // determine if this is a new cycle
   u64 nextTime = gSim->futureCycle(clock_, 1);
   if (nextTime_ != nextTime) {
     nextTime_ = nextTime;
 
-    // push in a new map
-    destMaps_.push_front(std::vector<Flit*>(numOutputs_, nullptr));
+    // the slot must have been drained 'latency_' cycles ago
+    assert(!occupied_.rowAny(slot));
 
-    // schedule an event for the new map
+    // schedule an event for the slot
     addEvent(gSim->futureCycle(clock_, latency_), 1, nullptr, 0);
   }
 
-  std::vector<Flit*>& map = destMaps_.front();
   // check to ensure the output has not been double booked
-  assert(map.at(_destId) == nullptr);
+  assert(_destId < numOutputs_);
+  u32 lane = _destId * width_;
+  if (width_ > 1) {
+    // use the first free lane of the output
+    u32 end = lane + width_;
+    while ((lane < end) && occupied_.test(slot, lane)) {
+      lane++;
+    }
+    assert(lane < end);
+  }
+  assert(!occupied_.test(slot, lane));
   // map in the info
-  map.at(_destId) = _flit;
+  slots_[((u64)slot * numOutputs_ * width_) + lane] = _flit;
+  occupied_.set(slot, lane);
 }
 
 void Crossbar::processEvent(void* _event, s32 _type) {
   assert(gSim->epsilon() == 1);
-  assert(destMaps_.size() >= 1);
 
-  // pull out the next map
-  assert(destMaps_.empty() == false);
-  std::vector<Flit*>& map = destMaps_.back();
-
-  // send all flits
-  for (u32 i = 0; i < map.size(); i++) {
-    if (map.at(i)) {
-      u32 port = receivers_.at(i).first;
+  // find the slot of the injection cycle
+  u64 cycle = gSim->cycle(clock_);
+  assert(cycle >= latency_);
+  u32 slot = (cycle - latency_) % numSlots_;
+  assert(occupied_.rowAny(slot));
+
+  // send all flits, visiting only the occupied lanes
+  Flit** flits = &slots_[(u64)slot * numOutputs_ * width_];
+  u64* occupied = occupied_.row(slot);
+  for (u32 w = 0; w < occupied_.rowWords(); w++) {
+    while (occupied[w] != 0) {
+      u32 lane = (w * 64) + __builtin_ctzll(occupied[w]);
+      occupied[w] &= occupied[w] - 1;
+      u32 output = (width_ == 1) ? lane : lane / width_;
+      u32 port = receivers_[output].first;
       assert(port != U32_MAX);
-      FlitReceiver* receiver = receivers_.at(i).second;
+      FlitReceiver* receiver = receivers_[output].second;
       assert(receiver != nullptr);
-      receiver->receiveFlit(port, map.at(i));
+      Flit* flit = flits[lane];
+      flits[lane] = nullptr;
+      receiver->receiveFlit(port, flit);
     }
   }
-
-  // pop the map
-  destMaps_.pop_back();
 }
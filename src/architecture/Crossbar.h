@@ -18,7 +18,6 @@
 #include <json/json.h>
 #include <prim/prim.h>
 
-#include <list>
 #include <string>
 #include <utility>
 #include <vector>
@@ -26,6 +25,7 @@
 #include "event/Component.h"
 #include "types/Flit.h"
 #include "types/FlitReceiver.h"
+#include "util/BitMatrix.h"
 
 class Crossbar : public Component {
  public:
@@ -36,6 +36,9 @@ class Crossbar : public Component {
   u32 numInputs() const;
   u32 numOutputs() const;
   void setReceiver(u32 _destId, FlitReceiver* _receiver, u32 _destPort);
+  // allows each output to receive up to '_width' flits per cycle, this must be
+  //  called before any flit is injected
+  void setWidth(u32 _width);
   // call multiple times for multicast
   void inject(Flit* _flit, u32 _srcId, u32 _destId);
   void processEvent(void* _event, s32 _type) override;
@@ -45,9 +48,16 @@ class Crossbar : public Component {
   const u64 latency_;
   const u32 numInputs_;
   const u32 numOutputs_;
+  u32 width_;
   std::vector<std::pair<u32, FlitReceiver*> > receivers_;
   u64 nextTime_;
-  std::list<std::vector<Flit*> > destMaps_;
+
+  // the schedule is a ring of 'latency_+1' slots indexed by injection cycle,
+  //  each slot holds 'width_' lanes per output and a row of 'occupied_' marks
+  //  which lanes received a flit
+  const u32 numSlots_;
+  std::vector<Flit*> slots_;
+  BitMatrix occupied_;
 };
 
 #endif  // ARCHITECTURE_CROSSBAR_H_
@@ -17,6 +17,8 @@
 #include <cassert>
 #include <cstring>
 
+#include <algorithm>
+
 #include "allocator/Allocator.h"
 #include "types/Packet.h"
 
@@ -59,10 +61,16 @@ CrossbarScheduler::CrossbarScheduler(
   clientRequestPorts_.resize(numClients_, U32_MAX);
   clientRequestVcs_.resize(numClients_, U32_MAX);
   clientRequestFlits_.resize(numClients_, nullptr);
+  clientRequestSpeculative_.resize(numClients_, false);
+  clientRequestLengths_.resize(numClients_, 0);
+  clientGrantedFlits_.resize(numClients_, 0);
 
   // create the credit counters
   credits_.resize(totalVcs_, 0);
   maxCredits_.resize(totalVcs_, 0);
+  creditPools_.resize(totalVcs_, U32_MAX);
+  reservedCredits_.resize(totalVcs_, 0);
+  outstanding_.resize(totalVcs_, 0);
 
   // create arrays for allocator inputs and outputs
   requests_ = new bool[crossbarPorts_ * numClients_];
@@ -73,6 +81,7 @@ CrossbarScheduler::CrossbarScheduler(
   // create arrays for handling port locks
   anyRequests_.resize(crossbarPorts_, false);
   portLocks_.resize(crossbarPorts_, U32_MAX);
+  nonSpecRequests_.resize(crossbarPorts_, false);
 
   // create the allocator
   allocator_ = Allocator::create(
@@ -87,7 +96,20 @@ CrossbarScheduler::CrossbarScheduler(
     }
   }
 
+  // no speedup limits by default
+  clientsPerInput_ = 1;
+  inputSpeedup_ = 0;
+  portsPerOutput_ = 1;
+  outputSpeedup_ = 0;
+
+  // all ports accept one grant per cycle by default
+  portWidths_.resize(crossbarPorts_, 1);
+  maxPortWidth_ = 1;
+  clientLaneGrant_.resize(numClients_, false);
+  lanePriority_ = 0;
+
   // initialize state variables
+  speculativeRequests_ = 0;
   eventAction_ = EventAction::NONE;
 }
 
@@ -115,8 +137,83 @@ void CrossbarScheduler::setClient(u32 _id, Client* _client) {
   clients_.at(_id) = _client;
 }
 
+void CrossbarScheduler::setSpeedup(u32 _clientsPerInput, u32 _inputSpeedup,
+                                   u32 _portsPerOutput, u32 _outputSpeedup) {
+  assert(_clientsPerInput > 0);
+  assert(numClients_ % _clientsPerInput == 0);
+  assert(_portsPerOutput > 0);
+  assert(crossbarPorts_ % _portsPerOutput == 0);
+
+  clientsPerInput_ = _clientsPerInput;
+  inputSpeedup_ = _inputSpeedup;
+  inputPriorities_.resize(numClients_ / clientsPerInput_, 0);
+  inputGrants_.resize(numClients_ / clientsPerInput_, 0);
+  portsPerOutput_ = _portsPerOutput;
+  outputSpeedup_ = _outputSpeedup;
+  outputPriorities_.resize(crossbarPorts_ / portsPerOutput_, 0);
+  outputGrants_.resize(crossbarPorts_ / portsPerOutput_, 0);
+  speedupCandidates_.resize(numClients_, false);
+  speedupGrants_.resize(numClients_, false);
+  portWanted_.resize(crossbarPorts_, false);
+  portOffered_.resize(crossbarPorts_, false);
+  portGranted_.resize(crossbarPorts_, false);
+}
+
+void CrossbarScheduler::setPortWidth(u32 _port, u32 _width) {
+  assert(_port < crossbarPorts_);
+  assert(_width > 0);
+  portWidths_.at(_port) = _width;
+  maxPortWidth_ = std::max(maxPortWidth_, _width);
+  portLanes_.resize(crossbarPorts_, 0);
+}
+
 void CrossbarScheduler::request(u32 _client, u32 _port, u32 _vcIdx,
                                 Flit* _flit) {
+  setRequest(_client, _port, _vcIdx, _flit, 1, false);
+}
+
+void CrossbarScheduler::request(u32 _client, u32 _port, u32 _vcIdx,
+                                Flit* _flit, u32 _flits) {
+  setRequest(_client, _port, _vcIdx, _flit, _flits, false);
+}
+
+void CrossbarScheduler::speculativeRequest(u32 _client, u32 _port,
+                                           u32 _vcIdx, Flit* _flit) {
+  setRequest(_client, _port, _vcIdx, _flit, 1, true);
+}
+
+void CrossbarScheduler::releaseLock(u32 _client, u32 _port) {
+  assert(_client < numClients_);
+  assert(_port < crossbarPorts_);
+  if (portLocks_[_port] == _client) {
+    portLocks_[_port] = U32_MAX;
+  }
+}
+
+u32 CrossbarScheduler::grantedFlits(u32 _client) const {
+  return clientGrantedFlits_.at(_client);
+}
+
+bool CrossbarScheduler::sufficientCredits(u32 _vcIdx,
+                                          const Flit* _flit) const {
+  assert(_vcIdx < totalVcs_);
+  if (fullPacket_) {
+    // packet-buffer flow control
+    if (_flit->isHead()) {
+      u32 packetSize = _flit->packet()->numFlits();
+      assert(maxCredits_[_vcIdx] >= packetSize);  // buffer is large enough
+      return credits_[_vcIdx] >= packetSize;
+    }
+    return true;
+  } else {
+    // flit-buffer flow control
+    return availableCredits(_vcIdx) > 0;
+  }
+}
+
+void CrossbarScheduler::setRequest(u32 _client, u32 _port, u32 _vcIdx,
+                                   Flit* _flit, u32 _flits,
+                                   bool _speculative) {
   assert(gSim->epsilon() >= 1);
   assert(_client < numClients_);
   assert(clientRequestPorts_[_client] == U32_MAX);
@@ -124,11 +221,18 @@ void CrossbarScheduler::request(u32 _client, u32 _port, u32 _vcIdx,
   assert(clientRequestFlits_[_client] == nullptr);
   assert(_vcIdx < totalVcs_);
   assert(_port < crossbarPorts_);
+  assert(_flits > 0);
+  assert(_flit->id() + _flits <= _flit->packet()->numFlits());
 
   // set request
   clientRequestPorts_[_client] = _port;
+  clientRequestLengths_[_client] = _flits;
   clientRequestVcs_[_client] = _vcIdx;
   clientRequestFlits_[_client] = _flit;
+  clientRequestSpeculative_[_client] = _speculative;
+  if (_speculative) {
+    speculativeRequests_++;
+  }
   anyRequests_[_port] = true;
   u64 idx = index(_client, _port);
   requests_[idx] = true;
@@ -149,6 +253,22 @@ void CrossbarScheduler::initCredits(u32 _vcIdx, u32 _credits) {
   maxCredits_[_vcIdx] = _credits;
 }
 
+void CrossbarScheduler::initSharedCredits(u32 _vcIdx, u32 _numVcs,
+                                          u32 _reserved, u32 _shared) {
+  // the shared credits of a packet could be taken by other VCs
+  assert(!fullPacket_);
+  assert(_vcIdx + _numVcs <= totalVcs_);
+
+  u32 pool = sharedCredits_.size();
+  sharedCredits_.push_back(_shared);
+  for (u32 vc = _vcIdx; vc < _vcIdx + _numVcs; vc++) {
+    creditPools_[vc] = pool;
+    reservedCredits_[vc] = _reserved;
+    credits_[vc] = _reserved;
+    maxCredits_[vc] = _reserved + _shared;
+  }
+}
+
 void CrossbarScheduler::incrementCredit(u32 _vcIdx) {
   assert(gSim->epsilon() >= 1);
   assert(_vcIdx < totalVcs_);
@@ -166,14 +286,30 @@ void CrossbarScheduler::incrementCredit(u32 _vcIdx) {
 void CrossbarScheduler::decrementCredit(u32 _vcIdx) {
   assert(_vcIdx < totalVcs_);
 
-  // decrement the credit count
-  assert(credits_[_vcIdx] > 0);
-  credits_[_vcIdx]--;
+  // decrement the credit count, pooled VCs use their reserved credits first
+  if (creditPools_[_vcIdx] == U32_MAX) {
+    assert(credits_[_vcIdx] > 0);
+    credits_[_vcIdx]--;
+  } else {
+    outstanding_[_vcIdx]++;
+    if (credits_[_vcIdx] > 0) {
+      credits_[_vcIdx]--;
+    } else {
+      u32 pool = creditPools_[_vcIdx];
+      assert(sharedCredits_[pool] > 0);
+      sharedCredits_[pool]--;
+    }
+  }
 }
 
 u32 CrossbarScheduler::getCreditCount(u32 _vcIdx) const {
   assert(_vcIdx < totalVcs_);
-  return credits_[_vcIdx];
+  return availableCredits(_vcIdx);
+}
+
+u32 CrossbarScheduler::getMaxCreditCount(u32 _vcIdx) const {
+  assert(_vcIdx < totalVcs_);
+  return maxCredits_[_vcIdx];
 }
 
 void CrossbarScheduler::processEvent(void* _event, s32 _type) {
@@ -185,8 +321,14 @@ void CrossbarScheduler::processEvent(void* _event, s32 _type) {
     u32 vc = it->first;
     u32 incr = it->second;
     assert(vc < totalVcs_);
-    credits_[vc] += incr;
-    assert(credits_[vc] <= maxCredits_[vc]);
+    if (creditPools_[vc] == U32_MAX) {
+      credits_[vc] += incr;
+      assert(credits_[vc] <= maxCredits_[vc]);
+    } else {
+      for (u32 i = 0; i < incr; i++) {
+        returnCredit(vc);
+      }
+    }
   }
   incrCredits_.clear();
 
@@ -199,22 +341,9 @@ void CrossbarScheduler::processEvent(void* _event, s32 _type) {
         u32 port = clientRequestPorts_[c];
         u32 vc = clientRequestVcs_[c];
         u64 idx = index(c, port);
-
-        if (fullPacket_) {
-          // packet-buffer flow control
-          const Flit* flit = clientRequestFlits_[c];
-          if (flit->isHead()) {
-            u32 packetSize = flit->packet()->numFlits();
-            assert(maxCredits_[vc] >= packetSize);  // buffer is large enough
-            if (requests_[idx] && credits_[vc] < packetSize) {
-              requests_[idx] = false;
-            }
-          }
-        } else {
-          // flit-buffer flow control
-          if (requests_[idx] && credits_[vc] == 0) {
-            requests_[idx] = false;
-          }
+        if (requests_[idx] &&
+            !sufficientCredits(vc, clientRequestFlits_[c])) {
+          requests_[idx] = false;
         }
       }
     }
@@ -249,6 +378,28 @@ void CrossbarScheduler::processEvent(void* _event, s32 _type) {
       }
     }
 
+    // non-speculative requests have priority over speculative requests
+    if (speculativeRequests_ > 0) {
+      for (u32 c = 0; c < numClients_; c++) {
+        u32 port = clientRequestPorts_[c];
+        if ((port != U32_MAX) && !clientRequestSpeculative_[c] &&
+            requests_[index(c, port)]) {
+          nonSpecRequests_[port] = true;
+        }
+      }
+      for (u32 c = 0; c < numClients_; c++) {
+        u32 port = clientRequestPorts_[c];
+        if ((port != U32_MAX) && clientRequestSpeculative_[c] &&
+            nonSpecRequests_[port]) {
+          requests_[index(c, port)] = false;
+        }
+      }
+      for (u32 p = 0; p < crossbarPorts_; p++) {
+        nonSpecRequests_[p] = false;
+      }
+      speculativeRequests_ = 0;
+    }
+
     // clear the any request vector
     for (u32 p = 0; p < crossbarPorts_; p++) {
       anyRequests_[p] = false;
@@ -257,8 +408,18 @@ void CrossbarScheduler::processEvent(void* _event, s32 _type) {
     // clear the grants (must do before allocate() call)
     memset(grants_, false, sizeof(bool) * numClients_ * crossbarPorts_);
 
-    // run the allocator
-    allocator_->allocate();
+    // run the allocator, limited speedup needs several rounds
+    if (((inputSpeedup_ > 0) && (inputSpeedup_ < clientsPerInput_)) ||
+        ((outputSpeedup_ > 0) && (outputSpeedup_ < portsPerOutput_))) {
+      allocateSpeedup();
+    } else {
+      allocator_->allocate();
+    }
+
+    // wide ports may accept more grants
+    if (maxPortWidth_ > 1) {
+      allocateLanes();
+    }
 
     // deliver responses, reset requests, if required lock ports
     for (u32 c = 0; c < numClients_; c++) {
@@ -269,17 +430,26 @@ void CrossbarScheduler::processEvent(void* _event, s32 _type) {
         clientRequestVcs_[c] = U32_MAX;
         const Flit* flit = clientRequestFlits_[c];
         clientRequestFlits_[c] = nullptr;
+        clientRequestSpeculative_[c] = false;
         u64 idx = index(c, port);
+        if (maxPortWidth_ == 1) {
+          clientGrantedFlits_[c] = grants_[idx] ? 1 : 0;
+        }
 
         u32 granted = U32_MAX;
         if (grants_[idx]) {
           granted = port;
-          assert(credits_[vc] > 0);
-
-          // if needed, lock the port
-          if (packetLock_) {
-            // handle port locking
-            portLocks_[port] = flit->isTail() ? U32_MAX : c;
+          assert(availableCredits(vc) > 0);
+
+          // if needed, lock the port (extra lanes don't take the lock)
+          if (packetLock_ && !clientLaneGrant_[c]) {
+            // handle port locking, the last flit granted decides
+            const Flit* last = flit;
+            if (clientGrantedFlits_[c] > 1) {
+              last = flit->packet()->getFlit(
+                  flit->id() + clientGrantedFlits_[c] - 1);
+            }
+            portLocks_[port] = last->isTail() ? U32_MAX : c;
           }
         }
         requests_[idx] = false;
@@ -293,6 +463,262 @@ void CrossbarScheduler::processEvent(void* _event, s32 _type) {
   eventAction_ = EventAction::NONE;
 }
 
+void CrossbarScheduler::allocateSpeedup() {
+  const u32 inputLimit = (inputSpeedup_ == 0) ? U32_MAX : inputSpeedup_;
+  const u32 outputLimit = (outputSpeedup_ == 0) ? U32_MAX : outputSpeedup_;
+
+  // the filtered requests are the candidates of the allocation rounds
+  for (u32 c = 0; c < numClients_; c++) {
+    u32 port = clientRequestPorts_[c];
+    speedupCandidates_[c] = (port != U32_MAX) && requests_[index(c, port)];
+    speedupGrants_[c] = false;
+    if (port != U32_MAX) {
+      requests_[index(c, port)] = false;
+    }
+  }
+  std::fill(inputGrants_.begin(), inputGrants_.end(), 0);
+  std::fill(outputGrants_.begin(), outputGrants_.end(), 0);
+  std::fill(portGranted_.begin(), portGranted_.end(), false);
+
+  // each round offers the allocator only as many ports of each output and
+  //  clients of each input as they can still accept, so every grant is kept
+  //  and the arbiters only advance for kept grants. the rounds continue while
+  //  clients that lost their port belong to inputs that aren't full.
+  while (true) {
+    // find the ports wanted by candidates of inputs that aren't full
+    std::fill(portWanted_.begin(), portWanted_.end(), false);
+    for (u32 c = 0; c < numClients_; c++) {
+      if (speedupCandidates_[c] &&
+          (inputGrants_[c / clientsPerInput_] < inputLimit)) {
+        portWanted_[clientRequestPorts_[c]] = true;
+      }
+    }
+
+    // each output offers its wanted ports, chosen round robin
+    for (u32 output = 0; output < outputPriorities_.size(); output++) {
+      u32 base = output * portsPerOutput_;
+      u32 remaining = outputLimit - outputGrants_[output];
+      for (u32 offset = 0; offset < portsPerOutput_; offset++) {
+        u32 p = base + ((outputPriorities_[output] + offset) %
+                        portsPerOutput_);
+        portOffered_[p] = (remaining > 0) && portWanted_[p];
+        if (portOffered_[p]) {
+          remaining--;
+        }
+      }
+    }
+
+    // each input requests the offered ports with its candidates, chosen
+    //  round robin
+    bool any = false;
+    for (u32 input = 0; input < inputPriorities_.size(); input++) {
+      u32 base = input * clientsPerInput_;
+      u32 remaining = inputLimit - inputGrants_[input];
+      for (u32 offset = 0; (offset < clientsPerInput_) && (remaining > 0);
+           offset++) {
+        u32 c = base + ((inputPriorities_[input] + offset) %
+                        clientsPerInput_);
+        u32 port = clientRequestPorts_[c];
+        if (speedupCandidates_[c] && portOffered_[port]) {
+          requests_[index(c, port)] = true;
+          remaining--;
+          any = true;
+        }
+      }
+    }
+    if (!any) {
+      break;
+    }
+
+    // run the allocator on this round's requests
+    memset(grants_, false, sizeof(bool) * numClients_ * crossbarPorts_);
+    allocator_->allocate();
+
+    bool granted = false;
+    for (u32 c = 0; c < numClients_; c++) {
+      u32 port = clientRequestPorts_[c];
+      if (port == U32_MAX) {
+        continue;
+      }
+      u64 idx = index(c, port);
+      requests_[idx] = false;
+      if (grants_[idx]) {
+        speedupCandidates_[c] = false;
+        speedupGrants_[c] = true;
+        portGranted_[port] = true;
+        inputGrants_[c / clientsPerInput_]++;
+        outputGrants_[port / portsPerOutput_]++;
+        granted = true;
+      }
+    }
+    if (!granted) {
+      break;
+    }
+
+    // the clients that lost their port are no longer candidates
+    for (u32 c = 0; c < numClients_; c++) {
+      if (speedupCandidates_[c] && portGranted_[clientRequestPorts_[c]]) {
+        speedupCandidates_[c] = false;
+      }
+    }
+  }
+
+  // the round robin priorities move past the last grant of each input and
+  //  each output
+  for (u32 input = 0; input < inputPriorities_.size(); input++) {
+    u32 base = input * clientsPerInput_;
+    u32 last = U32_MAX;
+    for (u32 offset = 0; offset < clientsPerInput_; offset++) {
+      u32 c = base + ((inputPriorities_[input] + offset) % clientsPerInput_);
+      if (speedupGrants_[c]) {
+        last = c - base;
+      }
+    }
+    if (last != U32_MAX) {
+      inputPriorities_[input] = (last + 1) % clientsPerInput_;
+    }
+  }
+  for (u32 output = 0; output < outputPriorities_.size(); output++) {
+    u32 base = output * portsPerOutput_;
+    u32 last = U32_MAX;
+    for (u32 offset = 0; offset < portsPerOutput_; offset++) {
+      u32 p = base + ((outputPriorities_[output] + offset) % portsPerOutput_);
+      if (portGranted_[p]) {
+        last = p - base;
+      }
+    }
+    if (last != U32_MAX) {
+      outputPriorities_[output] = (last + 1) % portsPerOutput_;
+    }
+  }
+
+  // the grants of all rounds
+  for (u32 c = 0; c < numClients_; c++) {
+    u32 port = clientRequestPorts_[c];
+    if (port != U32_MAX) {
+      grants_[index(c, port)] = speedupGrants_[c];
+    }
+  }
+}
+
+void CrossbarScheduler::allocateLanes() {
+  // the lanes take credits from copies of the counters so the flits granted
+  //  in a cycle can't overdraw them
+  laneCredits_ = credits_;
+  laneSharedCredits_ = sharedCredits_;
+  std::fill(portLanes_.begin(), portLanes_.end(), 0);
+
+  // the allocator granted the first lane of each port
+  for (u32 c = 0; c < numClients_; c++) {
+    u32 port = clientRequestPorts_[c];
+    clientGrantedFlits_[c] = 0;
+    clientLaneGrant_[c] = false;
+    if ((port != U32_MAX) && grants_[index(c, port)]) {
+      takeLaneCredit(clientRequestVcs_[c]);
+      clientGrantedFlits_[c] = 1;
+      portLanes_[port]++;
+    }
+  }
+
+  // the granted clients continue their packets on the remaining lanes
+  for (u32 c = 0; c < numClients_; c++) {
+    if (clientGrantedFlits_[c] > 0) {
+      fillLanes(c);
+    }
+  }
+
+  // the lanes still free go to the other clients, chosen round robin. this
+  //  doesn't run the allocator so its arbiters only move for the first lane.
+  u32 last = U32_MAX;
+  for (u32 offset = 0; offset < numClients_; offset++) {
+    u32 c = (lanePriority_ + offset) % numClients_;
+    u32 port = clientRequestPorts_[c];
+    if ((port == U32_MAX) || (clientGrantedFlits_[c] > 0) ||
+        (portWidths_[port] == 1) ||
+        (portLanes_[port] == portWidths_[port]) ||
+        (!sufficientLaneCredits(clientRequestVcs_[c],
+                                clientRequestFlits_[c]))) {
+      continue;
+    }
+    takeLaneCredit(clientRequestVcs_[c]);
+    clientGrantedFlits_[c] = 1;
+    clientLaneGrant_[c] = true;
+    portLanes_[port]++;
+    grants_[index(c, port)] = true;
+    fillLanes(c);
+    last = c;
+  }
+  if (last != U32_MAX) {
+    lanePriority_ = (last + 1) % numClients_;
+  }
+}
+
+void CrossbarScheduler::fillLanes(u32 _client) {
+  // the consecutive flits requested by the client use the free lanes
+  u32 port = clientRequestPorts_[_client];
+  u32 vc = clientRequestVcs_[_client];
+  const Flit* flit = clientRequestFlits_[_client];
+  while ((clientGrantedFlits_[_client] < clientRequestLengths_[_client]) &&
+         (portLanes_[port] < portWidths_[port])) {
+    const Flit* next = flit->packet()->getFlit(
+        flit->id() + clientGrantedFlits_[_client]);
+    if (!sufficientLaneCredits(vc, next)) {
+      break;
+    }
+    takeLaneCredit(vc);
+    clientGrantedFlits_[_client]++;
+    portLanes_[port]++;
+  }
+}
+
+bool CrossbarScheduler::sufficientLaneCredits(u32 _vcIdx,
+                                              const Flit* _flit) const {
+  if (fullPacket_) {
+    // packet-buffer flow control
+    if (_flit->isHead()) {
+      return laneCredits_[_vcIdx] >= _flit->packet()->numFlits();
+    }
+    return true;
+  }
+
+  // pooled VCs that have used their reserved credits need a shared credit
+  u32 pool = creditPools_[_vcIdx];
+  return (laneCredits_[_vcIdx] > 0) ||
+      ((pool != U32_MAX) && (laneSharedCredits_[pool] > 0));
+}
+
+void CrossbarScheduler::takeLaneCredit(u32 _vcIdx) {
+  // like decrementCredit(), pooled VCs use their reserved credits first
+  if (laneCredits_[_vcIdx] > 0) {
+    laneCredits_[_vcIdx]--;
+  } else {
+    u32 pool = creditPools_[_vcIdx];
+    assert(pool != U32_MAX);
+    assert(laneSharedCredits_[pool] > 0);
+    laneSharedCredits_[pool]--;
+  }
+}
+
+u32 CrossbarScheduler::availableCredits(u32 _vcIdx) const {
+  u32 pool = creditPools_[_vcIdx];
+  if (pool == U32_MAX) {
+    return credits_[_vcIdx];
+  }
+  return credits_[_vcIdx] + sharedCredits_[pool];
+}
+
+void CrossbarScheduler::returnCredit(u32 _vcIdx) {
+  // the flits beyond the reserved credits are held in the shared credits
+  assert(outstanding_[_vcIdx] > 0);
+  outstanding_[_vcIdx]--;
+  if (outstanding_[_vcIdx] >= reservedCredits_[_vcIdx]) {
+    sharedCredits_[creditPools_[_vcIdx]]++;
+  } else {
+    credits_[_vcIdx]++;
+    assert(credits_[_vcIdx] <= reservedCredits_[_vcIdx]);
+  }
+}
+
 u64 CrossbarScheduler::index(u64 _client, u64 _port) const {
   // this indexing contiguously places resources
   return (crossbarPorts_ * _client) + _port;
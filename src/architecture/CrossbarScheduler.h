@@ -37,6 +37,14 @@ class CrossbarScheduler : public Component, public CreditWatcher {
    *  port was allocated, U32_MAX is returned. If the client will use the
    *  port allocated, then decrementCredit() should be called during
    *  the same cycle after/during crossbarSchedulerResponse().
+   *
+   * Speculative requests are only granted when no non-speculative request
+   *  competes for the same port. A client that discards a speculative grant
+   *  must call releaseLock() so the port doesn't stay locked.
+   *
+   * On a wide port a client may request several consecutive flits of a
+   *  packet. grantedFlits() tells how many of them were granted, each one
+   *  needs its own decrementCredit() call.
    */
   class Client {
    public:
@@ -60,14 +68,47 @@ class CrossbarScheduler : public Component, public CreditWatcher {
   // links a client to the scheduler
   void setClient(u32 _id, Client* _client);
 
-  // requests to send a flit to a VC
+  // limits the grants per cycle of each group of consecutive clients (an
+  //  input port) and of each group of consecutive crossbar ports (an output
+  //  port). a speedup of 0 means unlimited. the limits are applied during
+  //  allocation, so an input whose chosen clients lose their ports can still
+  //  be matched through its other clients.
+  void setSpeedup(u32 _clientsPerInput, u32 _inputSpeedup,
+                  u32 _portsPerOutput, u32 _outputSpeedup);
+
+  // lets a crossbar port (i.e., a wide channel) accept up to '_width' flits
+  //  per cycle. the allocator grants the first flit, the remaining lanes go
+  //  to the consecutive flits of the granted client and then round robin to
+  //  other clients, ignoring port locks and without running the allocator
+  //  again.
+  void setPortWidth(u32 _port, u32 _width);
+
+  // requests to send a flit to a VC, or '_flits' consecutive flits of its
+  //  packet starting with '_flit'
   void request(u32 _client, u32 _port, u32 _vcIdx, Flit* _flit);
+  void request(u32 _client, u32 _port, u32 _vcIdx, Flit* _flit, u32 _flits);
+  void speculativeRequest(u32 _client, u32 _port, u32 _vcIdx, Flit* _flit);
+
+  // releases a port lock acquired by a discarded grant
+  void releaseLock(u32 _client, u32 _port);
+
+  // the number of flits granted to the client, valid during its response
+  u32 grantedFlits(u32 _client) const;
+
+  // determines if the flit could be sent to the VC with the current credits
+  bool sufficientCredits(u32 _vcIdx, const Flit* _flit) const;
 
   // credit counts
   void initCredits(u32 _vcIdx, u32 _credits) override;
+  // shares '_shared' credits among '_numVcs' consecutive VCs starting at
+  //  '_vcIdx' (i.e., a DAMQ downstream buffer), each VC also has '_reserved'
+  //  credits of its own
+  void initSharedCredits(u32 _vcIdx, u32 _numVcs, u32 _reserved,
+                         u32 _shared);
   void incrementCredit(u32 _vcIdx) override;
   void decrementCredit(u32 _vcIdx) override;
   u32 getCreditCount(u32 _vcIdx) const;
+  u32 getMaxCreditCount(u32 _vcIdx) const;
 
   // event processing
   void processEvent(void* _event, s32 _type) override;
@@ -83,20 +124,58 @@ class CrossbarScheduler : public Component, public CreditWatcher {
   std::vector<u32> clientRequestPorts_;
   std::vector<u32> clientRequestVcs_;
   std::vector<const Flit*> clientRequestFlits_;
+  std::vector<bool> clientRequestSpeculative_;
+  std::vector<u32> clientRequestLengths_;
+  std::vector<u32> clientGrantedFlits_;
+  u32 speculativeRequests_;
 
   std::vector<u32> credits_;
   std::vector<u32> maxCredits_;
   std::unordered_map<u32, u32> incrCredits_;
 
+  // shared credit pools, for each VC the pool it uses (U32_MAX if none), its
+  //  reserved credits, and its outstanding flits, for each pool the shared
+  //  credits available. 'credits_' holds the available reserved credits of
+  //  the VCs using a pool.
+  std::vector<u32> creditPools_;
+  std::vector<u32> reservedCredits_;
+  std::vector<u32> outstanding_;
+  std::vector<u32> sharedCredits_;
+
   bool* requests_;
   u64* metadatas_;
   bool* grants_;
 
   std::vector<bool> anyRequests_;  // someone has requested port
+  std::vector<bool> nonSpecRequests_;  // a non-speculative request is active
   std::vector<u32> portLocks_;  // output port locks
 
   Allocator* allocator_;
 
+  // crossbar speedup
+  u32 clientsPerInput_;
+  u32 inputSpeedup_;
+  std::vector<u32> inputPriorities_;
+  u32 portsPerOutput_;
+  u32 outputSpeedup_;
+  std::vector<u32> outputPriorities_;
+  std::vector<u32> inputGrants_;  // grants of each input this cycle
+  std::vector<u32> outputGrants_;  // grants of each output this cycle
+  std::vector<bool> speedupCandidates_;  // clients that may still be granted
+  std::vector<bool> speedupGrants_;
+  std::vector<bool> portWanted_;
+  std::vector<bool> portOffered_;
+  std::vector<bool> portGranted_;
+
+  // wide ports
+  std::vector<u32> portWidths_;
+  u32 maxPortWidth_;
+  std::vector<u32> portLanes_;  // flits granted to each port this cycle
+  std::vector<bool> clientLaneGrant_;  // granted only beyond the first lane
+  u32 lanePriority_;  // round robin client for the remaining lanes
+  std::vector<u32> laneCredits_;  // credits left this cycle
+  std::vector<u32> laneSharedCredits_;  // shared credits left this cycle
+
   const bool fullPacket_;  // head packets need full packet downstream space
   const bool packetLock_;  // packets lock the channel
   const bool idleUnlock_;  // locks are deactivated when idle (others want)
@@ -104,6 +183,16 @@ class CrossbarScheduler : public Component, public CreditWatcher {
   enum class EventAction : u8 { NONE = 0, CREDITS = 1, RUNALLOC = 2 };
   EventAction eventAction_;
 
+  void setRequest(u32 _client, u32 _port, u32 _vcIdx, Flit* _flit,
+                  u32 _flits, bool _speculative);
+  void allocateSpeedup();
+  void allocateLanes();
+  void fillLanes(u32 _client);
+  bool sufficientLaneCredits(u32 _vcIdx, const Flit* _flit) const;
+  void takeLaneCredit(u32 _vcIdx);
+  u32 availableCredits(u32 _vcIdx) const;
+  void returnCredit(u32 _vcIdx);
+
   // this creates an index for requests_, metadatas_, vcs_, and grants_
   u64 index(u64 _client, u64 _port) const;
 };
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "architecture/CrossbarScheduler.h"
 #include "event/Component.h"
@@ -209,3 +210,432 @@ TEST(CrossbarScheduler, basic) {
     }
   }
 }
+
+class SpeculativeTestClient : public CrossbarScheduler::Client,
+                              public Component {
+ public:
+  SpeculativeTestClient(u32 _id, CrossbarScheduler* _xbarSch, u32 _port,
+                        bool _speculative, u32 _vcIdx = U32_MAX,
+                        u64 _metadata = 1000)
+      : Component("TestClient_" + std::to_string(_id), nullptr),
+        id_(_id), xbarSch_(_xbarSch), port_(_port),
+        vcIdx_(_vcIdx == U32_MAX ? _port : _vcIdx),
+        speculative_(_speculative), response_(U32_MAX), responded_(false) {
+    xbarSch_->setClient(id_, this);
+    packet_ = new Packet(0, 1, nullptr);
+    flit_ = new Flit(0, true, true, packet_);
+    packet_->setFlit(0, flit_);
+    packet_->setMetadata(_metadata);
+    addEvent(gSim->time(), 1, nullptr, 0);
+  }
+
+  ~SpeculativeTestClient() {
+    delete packet_;
+  }
+
+  void processEvent(void* _event, s32 _type) override {
+    if (speculative_) {
+      xbarSch_->speculativeRequest(id_, port_, vcIdx_, flit_);
+    } else {
+      xbarSch_->request(id_, port_, vcIdx_, flit_);
+    }
+  }
+
+  void crossbarSchedulerResponse(u32 _port, u32 _vcIdx) override {
+    responded_ = true;
+    response_ = _port;
+  }
+
+  bool responded() const {
+    return responded_;
+  }
+
+  u32 response() const {
+    return response_;
+  }
+
+ private:
+  u32 id_;
+  CrossbarScheduler* xbarSch_;
+  u32 port_;
+  u32 vcIdx_;
+  bool speculative_;
+  u32 response_;
+  bool responded_;
+  Packet* packet_;
+  Flit* flit_;
+};
+
+TEST(CrossbarScheduler, speculative) {
+  TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+  Json::Value arbSettings;
+  arbSettings["type"] = "random";
+  Json::Value allocSettings;
+  allocSettings["type"] = "r_separable";
+  allocSettings["resource_arbiter"] = arbSettings;
+  allocSettings["slip_latch"] = true;
+  Json::Value schSettings;
+  schSettings["allocator"] = allocSettings;
+  schSettings["full_packet"] = false;
+  schSettings["packet_lock"] = false;
+  schSettings["idle_unlock"] = false;
+  CrossbarScheduler* xbarSch = new CrossbarScheduler(
+      "XbarSch", nullptr, 3, 2, 2, 0, Simulator::Clock::ROUTER, schSettings);
+  for (u32 v = 0; v < 2; v++) {
+    xbarSch->initCredits(v, 1);
+  }
+
+  // the non-speculative request on port 0 wins over the speculative request,
+  //  the uncontested speculative request on port 1 is granted
+  SpeculativeTestClient spec0(0, xbarSch, 0, true);
+  SpeculativeTestClient nonSpec0(1, xbarSch, 0, false);
+  SpeculativeTestClient spec1(2, xbarSch, 1, true);
+
+  gSim->initialize();
+  gSim->simulate();
+
+  ASSERT_TRUE(spec0.responded());
+  ASSERT_TRUE(nonSpec0.responded());
+  ASSERT_TRUE(spec1.responded());
+  ASSERT_EQ(spec0.response(), U32_MAX);
+  ASSERT_EQ(nonSpec0.response(), 0u);
+  ASSERT_EQ(spec1.response(), 1u);
+
+  delete xbarSch;
+}
+
+static Json::Value speedupSchedulerSettings() {
+  Json::Value arbSettings;
+  arbSettings["type"] = "random";
+  Json::Value allocSettings;
+  allocSettings["type"] = "r_separable";
+  allocSettings["resource_arbiter"] = arbSettings;
+  allocSettings["slip_latch"] = true;
+  Json::Value schSettings;
+  schSettings["allocator"] = allocSettings;
+  schSettings["full_packet"] = false;
+  schSettings["packet_lock"] = false;
+  schSettings["idle_unlock"] = false;
+  return schSettings;
+}
+
+TEST(CrossbarScheduler, input_speedup) {
+  TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+  CrossbarScheduler* xbarSch = new CrossbarScheduler(
+      "XbarSch", nullptr, 4, 4, 4, 0, Simulator::Clock::ROUTER,
+      speedupSchedulerSettings());
+  for (u32 v = 0; v < 4; v++) {
+    xbarSch->initCredits(v, 1);
+  }
+
+  // two inputs of two clients each, one flit per input per cycle
+  xbarSch->setSpeedup(2, 1, 1, 0);
+
+  std::vector<SpeculativeTestClient*> clients;
+  for (u32 c = 0; c < 4; c++) {
+    clients.push_back(new SpeculativeTestClient(c, xbarSch, c, false));
+  }
+
+  gSim->initialize();
+  gSim->simulate();
+
+  for (u32 input = 0; input < 2; input++) {
+    u32 grants = 0;
+    for (u32 c = input * 2; c < (input + 1) * 2; c++) {
+      ASSERT_TRUE(clients.at(c)->responded());
+      if (clients.at(c)->response() != U32_MAX) {
+        ASSERT_EQ(clients.at(c)->response(), c);
+        grants++;
+      }
+    }
+    ASSERT_EQ(grants, 1u);
+  }
+
+  for (u32 c = 0; c < 4; c++) {
+    delete clients.at(c);
+  }
+  delete xbarSch;
+}
+
+TEST(CrossbarScheduler, input_speedup_rematch) {
+  TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+  Json::Value arbSettings;
+  arbSettings["type"] = "comparing";
+  arbSettings["greater"] = false;
+  Json::Value schSettings = speedupSchedulerSettings();
+  schSettings["allocator"]["resource_arbiter"] = arbSettings;
+  CrossbarScheduler* xbarSch = new CrossbarScheduler(
+      "XbarSch", nullptr, 4, 2, 2, 0, Simulator::Clock::ROUTER, schSettings);
+  for (u32 v = 0; v < 2; v++) {
+    xbarSch->initCredits(v, 4);
+  }
+
+  // two inputs of two clients each, one flit per input per cycle
+  xbarSch->setSpeedup(2, 1, 1, 0);
+
+  // client 2 is the first choice of input 1 but loses port 0 to client 0,
+  //  input 1 must then be matched to port 1 through client 3
+  SpeculativeTestClient client0(0, xbarSch, 0, false, 0, 1);
+  SpeculativeTestClient client1(1, xbarSch, 0, false, 0, 1000);
+  SpeculativeTestClient client2(2, xbarSch, 0, false, 0, 1000);
+  SpeculativeTestClient client3(3, xbarSch, 1, false, 1, 1000);
+
+  gSim->initialize();
+  gSim->simulate();
+
+  ASSERT_EQ(client0.response(), 0u);
+  ASSERT_EQ(client1.response(), U32_MAX);
+  ASSERT_EQ(client2.response(), U32_MAX);
+  ASSERT_EQ(client3.response(), 1u);
+
+  delete xbarSch;
+}
+
+TEST(CrossbarScheduler, output_speedup) {
+  TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+  CrossbarScheduler* xbarSch = new CrossbarScheduler(
+      "XbarSch", nullptr, 4, 4, 4, 0, Simulator::Clock::ROUTER,
+      speedupSchedulerSettings());
+  for (u32 v = 0; v < 4; v++) {
+    xbarSch->initCredits(v, 1);
+  }
+
+  // one output of four ports, two flits per cycle
+  xbarSch->setSpeedup(1, 0, 4, 2);
+
+  std::vector<SpeculativeTestClient*> clients;
+  for (u32 c = 0; c < 4; c++) {
+    clients.push_back(new SpeculativeTestClient(c, xbarSch, c, false));
+  }
+
+  gSim->initialize();
+  gSim->simulate();
+
+  u32 grants = 0;
+  for (u32 c = 0; c < 4; c++) {
+    ASSERT_TRUE(clients.at(c)->responded());
+    if (clients.at(c)->response() != U32_MAX) {
+      ASSERT_EQ(clients.at(c)->response(), c);
+      grants++;
+    }
+  }
+  ASSERT_EQ(grants, 2u);
+
+  for (u32 c = 0; c < 4; c++) {
+    delete clients.at(c);
+  }
+  delete xbarSch;
+}
+
+TEST(CrossbarScheduler, port_width) {
+  TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+  CrossbarScheduler* xbarSch = new CrossbarScheduler(
+      "XbarSch", nullptr, 5, 5, 2, 0, Simulator::Clock::ROUTER,
+      speedupSchedulerSettings());
+  for (u32 v = 0; v < 5; v++) {
+    xbarSch->initCredits(v, 1);
+  }
+
+  // port 0 accepts three flits per cycle, port 1 one
+  xbarSch->setPortWidth(0, 3);
+
+  // four clients want port 0, one wants port 1, each on its own VC
+  std::vector<SpeculativeTestClient*> clients;
+  for (u32 c = 0; c < 5; c++) {
+    clients.push_back(new SpeculativeTestClient(
+        c, xbarSch, c < 4 ? 0 : 1, false, c));
+  }
+
+  gSim->initialize();
+  gSim->simulate();
+
+  u32 grants = 0;
+  for (u32 c = 0; c < 4; c++) {
+    ASSERT_TRUE(clients.at(c)->responded());
+    if (clients.at(c)->response() != U32_MAX) {
+      ASSERT_EQ(clients.at(c)->response(), 0u);
+      grants++;
+    }
+  }
+  ASSERT_EQ(grants, 3u);
+  ASSERT_EQ(clients.at(4)->response(), 1u);
+
+  for (u32 c = 0; c < 5; c++) {
+    delete clients.at(c);
+  }
+  delete xbarSch;
+}
+
+class CreditReturner : public Component {
+ public:
+  CreditReturner(CrossbarScheduler* _xbarSch, u32 _vcIdx, u32 _credits)
+      : Component("CreditReturner", nullptr), xbarSch_(_xbarSch),
+        vcIdx_(_vcIdx), credits_(_credits) {
+    addEvent(gSim->time(), 1, nullptr, 0);
+  }
+
+  void processEvent(void* _event, s32 _type) override {
+    for (u32 c = 0; c < credits_; c++) {
+      xbarSch_->incrementCredit(vcIdx_);
+    }
+  }
+
+ private:
+  CrossbarScheduler* xbarSch_;
+  u32 vcIdx_;
+  u32 credits_;
+};
+
+TEST(CrossbarScheduler, shared_credits) {
+  TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+  CrossbarScheduler* xbarSch = new CrossbarScheduler(
+      "XbarSch", nullptr, 1, 3, 1, 0, Simulator::Clock::ROUTER,
+      speedupSchedulerSettings());
+
+  // VC 0 has private credits, VCs 1 and 2 reserve 1 credit and share 2
+  xbarSch->initCredits(0, 3);
+  xbarSch->initSharedCredits(1, 2, 1, 2);
+  ASSERT_EQ(xbarSch->getCreditCount(0), 3u);
+  ASSERT_EQ(xbarSch->getCreditCount(1), 3u);
+  ASSERT_EQ(xbarSch->getMaxCreditCount(2), 3u);
+
+  // VC 1 uses its reserved credit then the shared credits
+  xbarSch->decrementCredit(1);
+  ASSERT_EQ(xbarSch->getCreditCount(1), 2u);
+  ASSERT_EQ(xbarSch->getCreditCount(2), 3u);
+  xbarSch->decrementCredit(1);
+  xbarSch->decrementCredit(1);
+  ASSERT_EQ(xbarSch->getCreditCount(1), 0u);
+  ASSERT_EQ(xbarSch->getCreditCount(2), 1u);
+  ASSERT_EQ(xbarSch->getCreditCount(0), 3u);
+
+  // VC 2 can still use its reserved credit
+  xbarSch->decrementCredit(2);
+  ASSERT_EQ(xbarSch->getCreditCount(2), 0u);
+
+  // the first credits returned to VC 1 refill the shared credits
+  CreditReturner returner(xbarSch, 1, 2);
+  gSim->initialize();
+  gSim->simulate();
+  ASSERT_EQ(xbarSch->getCreditCount(1), 2u);
+  ASSERT_EQ(xbarSch->getCreditCount(2), 2u);
+
+  delete xbarSch;
+}
+
+TEST(CrossbarScheduler, port_width_shared_credits) {
+  TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+  CrossbarScheduler* xbarSch = new CrossbarScheduler(
+      "XbarSch", nullptr, 3, 3, 1, 0, Simulator::Clock::ROUTER,
+      speedupSchedulerSettings());
+
+  // three VCs without reserved credits share a single credit
+  xbarSch->initSharedCredits(0, 3, 0, 1);
+
+  // the wide port could take all three flits but only one has a credit
+  xbarSch->setPortWidth(0, 3);
+  std::vector<SpeculativeTestClient*> clients;
+  for (u32 c = 0; c < 3; c++) {
+    clients.push_back(new SpeculativeTestClient(c, xbarSch, 0, false, c));
+  }
+
+  gSim->initialize();
+  gSim->simulate();
+
+  u32 grants = 0;
+  for (u32 c = 0; c < 3; c++) {
+    ASSERT_TRUE(clients.at(c)->responded());
+    if (clients.at(c)->response() != U32_MAX) {
+      grants++;
+    }
+  }
+  ASSERT_EQ(grants, 1u);
+
+  for (u32 c = 0; c < 3; c++) {
+    delete clients.at(c);
+  }
+  delete xbarSch;
+}
+
+class PacketTestClient : public CrossbarScheduler::Client,
+                         public Component {
+ public:
+  PacketTestClient(u32 _id, CrossbarScheduler* _xbarSch, u32 _port,
+                   u32 _vcIdx, u32 _numFlits)
+      : Component("TestClient_" + std::to_string(_id), nullptr),
+        id_(_id), xbarSch_(_xbarSch), port_(_port), vcIdx_(_vcIdx),
+        next_(0), cycles_(0) {
+    xbarSch_->setClient(id_, this);
+    packet_ = new Packet(0, _numFlits, nullptr);
+    for (u32 f = 0; f < _numFlits; f++) {
+      packet_->setFlit(f, new Flit(f, f == 0, f == _numFlits - 1, packet_));
+    }
+    packet_->setMetadata(1000);
+    addEvent(gSim->time(), 1, nullptr, 0);
+  }
+
+  ~PacketTestClient() {
+    delete packet_;
+  }
+
+  void processEvent(void* _event, s32 _type) override {
+    // request all remaining flits of the packet
+    u32 numFlits = packet_->numFlits();
+    xbarSch_->request(id_, port_, vcIdx_, packet_->getFlit(next_),
+                      numFlits - next_);
+  }
+
+  void crossbarSchedulerResponse(u32 _port, u32 _vcIdx) override {
+    cycles_++;
+    if (_port != U32_MAX) {
+      u32 flits = xbarSch_->grantedFlits(id_);
+      for (u32 f = 0; f < flits; f++) {
+        xbarSch_->decrementCredit(_vcIdx);
+      }
+      next_ += flits;
+    }
+    if (next_ < packet_->numFlits()) {
+      addEvent(gSim->time(), gSim->epsilon() + 1, nullptr, 0);
+    }
+  }
+
+  u32 cycles() const {
+    return cycles_;
+  }
+
+  bool done() const {
+    return next_ == packet_->numFlits();
+  }
+
+ private:
+  u32 id_;
+  CrossbarScheduler* xbarSch_;
+  u32 port_;
+  u32 vcIdx_;
+  u32 next_;
+  u32 cycles_;
+  Packet* packet_;
+};
+
+TEST(CrossbarScheduler, port_width_packet) {
+  for (u32 width : {1, 2, 4}) {
+    TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+    CrossbarScheduler* xbarSch = new CrossbarScheduler(
+        "XbarSch", nullptr, 1, 1, 1, 0, Simulator::Clock::ROUTER,
+        speedupSchedulerSettings());
+    xbarSch->initCredits(0, 16);
+    xbarSch->setPortWidth(0, width);
+
+    // one packet on one VC sends 'width' consecutive flits per cycle
+    PacketTestClient client(0, xbarSch, 0, 0, 16);
+
+    gSim->initialize();
+    gSim->simulate();
+
+    ASSERT_TRUE(client.done());
+    ASSERT_EQ(client.cycles(), 16u / width);
+    ASSERT_EQ(xbarSch->getCreditCount(0), 0u);
+
+    delete xbarSch;
+  }
+}
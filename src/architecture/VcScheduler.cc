@@ -33,18 +33,39 @@ VcScheduler::VcScheduler(const std::string& _name, const Component* _parent,
   assert(numClients_ > 0 && numClients_ != U32_MAX);
   assert(totalVcs_ > 0 && totalVcs_ != U32_MAX);
 
-  // create Client pointers and requested flags
+  // create Client pointers and request tracking
   clients_.resize(numClients_, nullptr);
-  clientRequested_.resize(numClients_, false);
+  clientRequested_.resize(1, numClients_);
+  clientRequests_.resize(numClients_);
+  requestBits_.resize(numClients_, totalVcs_);
 
-  // create the VC used flags
-  vcTaken_.resize(totalVcs_, false);
+  // no VCs are contended
+  vcWaiters_.resize(totalVcs_, 0);
+  vcLastWaiter_.resize(totalVcs_, U32_MAX);
 
-  // create arrays for allocator inputs and outputs
+  // all VCs start free
+  vcFree_.resize(1, totalVcs_);
+  for (u32 v = 0; v < totalVcs_; v++) {
+    vcFree_.set(0, v);
+  }
+
+  // requests can be masked by the credit count of the VC
+  assert(_settings.isMember("credit_threshold") &&
+         _settings["credit_threshold"].isUInt());
+  creditThreshold_ = _settings["credit_threshold"].asUInt();
+  creditSources_.resize(totalVcs_, nullptr);
+  creditSourceVcs_.resize(totalVcs_, U32_MAX);
+  if (creditThreshold_ > 0) {
+    vcEligible_.resize(1, totalVcs_);
+  }
+
+  // create arrays for allocator inputs and outputs, the request and grant
+  //  arrays are kept clear except for the entries of active requests
   requests_ = new bool[totalVcs_ * numClients_];
   memset(requests_, 0, sizeof(bool) * totalVcs_ * numClients_);
   metadatas_ = new u64[totalVcs_ * numClients_];
   grants_ = new bool[totalVcs_ * numClients_];
+  memset(grants_, 0, sizeof(bool) * totalVcs_ * numClients_);
 
   // create the allocator
   allocator_ = Allocator::create(
@@ -83,6 +104,16 @@ void VcScheduler::setClient(u32 _id, Client* _client) {
   clients_.at(_id) = _client;
 }
 
+void VcScheduler::setCreditSource(const CrossbarScheduler* _creditSource,
+                                  u32 _vcIdx) {
+  assert(_vcIdx + _creditSource->totalVcs() <= totalVcs_);
+  for (u32 v = 0; v < _creditSource->totalVcs(); v++) {
+    assert(creditSources_.at(_vcIdx + v) == nullptr);
+    creditSources_.at(_vcIdx + v) = _creditSource;
+    creditSourceVcs_.at(_vcIdx + v) = v;
+  }
+}
+
 void VcScheduler::request(u32 _client, u32 _vcIdx, u64 _metadata) {
   assert(gSim->epsilon() >= 1);
   assert(_client < numClients_);
@@ -90,9 +121,13 @@ void VcScheduler::request(u32 _client, u32 _vcIdx, u64 _metadata) {
 
   // set the request
   u64 idx = index(_client, _vcIdx);
-  requests_[idx] = true;
+  if (!requests_[idx]) {
+    requests_[idx] = true;
+    clientRequests_[_client].push_back(_vcIdx);
+    requestBits_.set(_client, _vcIdx);
+  }
   metadatas_[idx] = _metadata;
-  clientRequested_[_client] = true;
+  clientRequested_.set(0, _client);
 
   // ensure there is an event set to perform scheduling
   if (!allocEventSet_) {
@@ -103,8 +138,15 @@ void VcScheduler::request(u32 _client, u32 _vcIdx, u64 _metadata) {
 
 void VcScheduler::releaseVc(u32 _vcIdx) {
   assert(gSim->epsilon() >= 1);
-  assert(vcTaken_.at(_vcIdx) == true);
-  vcTaken_.at(_vcIdx) = false;
+  assert(_vcIdx < totalVcs_);
+  assert(!vcFree_.test(0, _vcIdx));
+  vcFree_.set(0, _vcIdx);
+}
+
+bool VcScheduler::contended(u32 _vcIdx, u32 _client) const {
+  assert(_vcIdx < totalVcs_);
+  return ((vcWaiters_[_vcIdx] > 1) ||
+          ((vcWaiters_[_vcIdx] == 1) && (vcLastWaiter_[_vcIdx] != _client)));
 }
 
 void VcScheduler::processEvent(void* _event, s32 _type) {
@@ -112,30 +154,53 @@ void VcScheduler::processEvent(void* _event, s32 _type) {
   assert(gSim->epsilon() == 0);
   allocEventSet_ = false;
 
+  // forget the contention of the last allocation
+  for (u32 v : contendedVcs_) {
+    vcWaiters_[v] = 0;
+    vcLastWaiter_[v] = U32_MAX;
+  }
+  contendedVcs_.clear();
+
   // check VC availability, mask out unavailable VC requests
-  for (u32 c = 0; c < numClients_; c++) {
-    if (clientRequested_[c]) {
-      for (u32 v = 0; v < totalVcs_; v++) {
-        u64 idx = index(c, v);
-        if (requests_[idx] && vcTaken_[v]) {
-          requests_[idx] = false;
+  const u64* free = vcFree_.row(0);
+  if (creditThreshold_ > 0) {
+    maskByCredits();
+    free = vcEligible_.row(0);
+  }
+  const u32 vcWords = requestBits_.rowWords();
+  const u64* requested = clientRequested_.row(0);
+  for (u32 cw = 0; cw < clientRequested_.rowWords(); cw++) {
+    for (u64 clients = requested[cw]; clients != 0;
+         clients &= clients - 1) {
+      u32 c = (cw * 64) + __builtin_ctzll(clients);
+      u64* requests = requestBits_.row(c);
+      for (u32 w = 0; w < vcWords; w++) {
+        u64 taken = requests[w] & ~free[w];
+        requests[w] &= free[w];
+        for (; taken != 0; taken &= taken - 1) {
+          u32 v = (w * 64) + __builtin_ctzll(taken);
+          requests_[index(c, v)] = false;
+          if (vcWaiters_[v] == 0) {
+            contendedVcs_.push_back(v);
+          }
+          vcWaiters_[v]++;
+          vcLastWaiter_[v] = c;
         }
       }
     }
   }
 
-  // clear the grants (must do before allocate() call)
-  memset(grants_, false, sizeof(bool) * totalVcs_ * numClients_);
-
   // run the allocator
   allocator_->allocate();
 
-  // deliver responses, mark used VCs, reset requests
-  for (u32 c = 0; c < numClients_; c++) {
-    if (clientRequested_[c]) {
-      clientRequested_[c] = false;
+  // deliver responses, mark used VCs, reset requests and grants
+  u64* active = clientRequested_.row(0);
+  for (u32 cw = 0; cw < clientRequested_.rowWords(); cw++) {
+    while (active[cw] != 0) {
+      u32 c = (cw * 64) + __builtin_ctzll(active[cw]);
+      active[cw] &= active[cw] - 1;
       u32 granted = U32_MAX;
-      for (u32 v = 0; v < totalVcs_; v++) {
+      for (u32 v : clientRequests_[c]) {
         u64 idx = index(c, v);
 
         // multiple grants to the same client? BAD
@@ -144,11 +209,14 @@ void VcScheduler::processEvent(void* _event, s32 _type) {
         // check for granted
         if ((granted == U32_MAX) && (grants_[idx])) {
           granted = v;
-          assert(vcTaken_[v] == false);
-          vcTaken_[v] = true;
+          assert(vcFree_.test(0, v));
+          vcFree_.clear(0, v);
         }
         requests_[idx] = false;
+        grants_[idx] = false;
       }
+      clientRequests_[c].clear();
+      requestBits_.clearRow(c);
       clients_[c]->vcSchedulerResponse(granted);
     }
   }
@@ -158,3 +226,32 @@ u64 VcScheduler::index(u64 _client, u64 _vcIdx) const {
   // this indexing contiguously places resources
   return (totalVcs_ * _client) + _vcIdx;
 }
+
+bool VcScheduler::eligible(u32 _vcIdx) const {
+  if (creditThreshold_ == 0) {
+    return true;
+  }
+
+  // an empty buffer is always eligible so that a threshold larger than the
+  //  buffer can't starve the VC
+  const CrossbarScheduler* source = creditSources_.at(_vcIdx);
+  assert(source != nullptr);
+  u32 sourceVc = creditSourceVcs_[_vcIdx];
+  u32 credits = source->getCreditCount(sourceVc);
+  return (credits >= creditThreshold_) ||
+      (credits >= source->getMaxCreditCount(sourceVc));
+}
+
+void VcScheduler::maskByCredits() {
+  const u64* free = vcFree_.row(0);
+  u64* masked = vcEligible_.row(0);
+  for (u32 w = 0; w < vcFree_.rowWords(); w++) {
+    masked[w] = free[w];
+    for (u64 vcs = free[w]; vcs != 0; vcs &= vcs - 1) {
+      u32 v = (w * 64) + __builtin_ctzll(vcs);
+      if (!eligible(v)) {
+        masked[w] &= ~((u64)1 << (v % 64));
+      }
+    }
+  }
+}
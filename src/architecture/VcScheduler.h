@@ -23,7 +23,9 @@
 #include <vector>
 
 #include "allocator/Allocator.h"
+#include "architecture/CrossbarScheduler.h"
 #include "event/Component.h"
+#include "util/BitMatrix.h"
 
 class VcScheduler : public Component {
  public:
@@ -53,10 +55,22 @@ class VcScheduler : public Component {
   // links a client to the scheduler
   void setClient(u32 _id, Client* _client);
 
+  // links a crossbar scheduler holding the credit counts of the VCs starting
+  //  at '_vcIdx', all VCs need a source when the credit threshold is non-zero
+  void setCreditSource(const CrossbarScheduler* _creditSource, u32 _vcIdx);
+
   // requesting and releasing VCs
   void request(u32 _client, u32 _vcIdx, u64 _metadata);
   void releaseVc(u32 _vcIdx);
 
+  // determines if a client other than '_client' was denied the VC because it
+  //  was taken during the last allocation
+  bool contended(u32 _vcIdx, u32 _client) const;
+
+  // determines if the VC passes the credit threshold (always true when the
+  //  threshold is zero)
+  bool eligible(u32 _vcIdx) const;
+
   // event processing
   void processEvent(void* _event, s32 _type) override;
 
@@ -66,9 +80,29 @@ class VcScheduler : public Component {
   const Simulator::Clock clock_;
 
   std::vector<Client*> clients_;
-  std::vector<bool> clientRequested_;
 
-  std::vector<bool> vcTaken_;
+  // the set of clients with requests this cycle and the sparse list of VCs
+  //  each of them requested, 'requestBits_' holds the same requests packed
+  //  per client so taken VCs can be masked a word at a time
+  BitMatrix clientRequested_;
+  std::vector<std::vector<u32> > clientRequests_;
+  BitMatrix requestBits_;
+
+  // free VCs packed in VC index order (i.e., grouped by output port)
+  BitMatrix vcFree_;
+
+  // free VCs lacking buffer space are masked out when a credit threshold is
+  //  set, 'vcEligible_' holds the free VCs passing the threshold
+  u32 creditThreshold_;
+  std::vector<const CrossbarScheduler*> creditSources_;  // per VC
+  std::vector<u32> creditSourceVcs_;  // VC index within the source
+  BitMatrix vcEligible_;
+
+  // the number of clients denied each VC because it was taken during the last
+  //  allocation, the last of them, and the list of these VCs
+  std::vector<u32> vcWaiters_;
+  std::vector<u32> vcLastWaiter_;
+  std::vector<u32> contendedVcs_;
 
   bool* requests_;
   u64* metadatas_;
@@ -78,6 +112,9 @@ class VcScheduler : public Component {
 
   // this creates an index for requests_, metadatas_, and grants_
   u64 index(u64 _client, u64 _vcIdx) const;
+
+  // computes 'vcEligible_' from the free VCs and the credit counts
+  void maskByCredits();
 };
 
 #endif  // ARCHITECTURE_VCSCHEDULER_H_
@@ -20,9 +20,11 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
-#include "event/Component.h"
+#include "architecture/CrossbarScheduler.h"
 #include "architecture/VcScheduler.h"
+#include "event/Component.h"
 
 #include "test/TestSetup_TEST.h"
 
@@ -195,6 +197,7 @@ TEST(VcScheduler, basic) {
         allocSettings["slip_latch"] = true;
         Json::Value schSettings;
         schSettings["allocator"] = allocSettings;
+        schSettings["credit_threshold"] = 0;
         VcScheduler* vcSch = new VcScheduler(
             "VcSch", nullptr, C, V, Simulator::Clock::ROUTER, schSettings);
         assert(vcSch->numClients() == C);
@@ -261,6 +264,7 @@ TEST(VcScheduler, dist) {
       allocSettings["slip_latch"] = false;
       Json::Value schSettings;
       schSettings["allocator"] = allocSettings;
+      schSettings["credit_threshold"] = 0;
       VcScheduler* vcSch = new VcScheduler(
           "VcSch", nullptr, C, V, Simulator::Clock::ROUTER, schSettings);
       assert(vcSch->numClients() == C);
@@ -291,3 +295,187 @@ TEST(VcScheduler, dist) {
     }
   }
 }
+
+class CreditMaskTestClient : public VcScheduler::Client, public Component {
+ public:
+  CreditMaskTestClient(u32 _id, VcScheduler* _vcSch,
+                       const std::vector<u32>& _vcs, u64 _time = 0)
+      : Component("TestClient_" + std::to_string(_id), nullptr),
+        id_(_id), vcSch_(_vcSch), vcs_(_vcs), response_(U32_MAX),
+        responded_(false) {
+    vcSch_->setClient(id_, this);
+    addEvent(_time, 1, nullptr, 0);
+  }
+
+  void processEvent(void* _event, s32 _type) override {
+    for (u32 v : vcs_) {
+      vcSch_->request(id_, v, 1000);
+    }
+  }
+
+  void vcSchedulerResponse(u32 _vcIdx) override {
+    responded_ = true;
+    response_ = _vcIdx;
+  }
+
+  bool responded() const {
+    return responded_;
+  }
+
+  u32 response() const {
+    return response_;
+  }
+
+ private:
+  u32 id_;
+  VcScheduler* vcSch_;
+  std::vector<u32> vcs_;
+  u32 response_;
+  bool responded_;
+};
+
+TEST(VcScheduler, credit_threshold) {
+  TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+  Json::Value arbSettings;
+  arbSettings["type"] = "random";
+  Json::Value allocSettings;
+  allocSettings["type"] = "rc_separable";
+  allocSettings["resource_arbiter"] = arbSettings;
+  allocSettings["client_arbiter"] = arbSettings;
+  allocSettings["iterations"] = 1;
+  allocSettings["slip_latch"] = true;
+  Json::Value schSettings;
+  schSettings["allocator"] = allocSettings;
+  schSettings["credit_threshold"] = 3;
+  VcScheduler* vcSch = new VcScheduler(
+      "VcSch", nullptr, 3, 3, Simulator::Clock::ROUTER, schSettings);
+
+  Json::Value xbarSchSettings;
+  xbarSchSettings["allocator"] = allocSettings;
+  xbarSchSettings["full_packet"] = false;
+  xbarSchSettings["packet_lock"] = false;
+  xbarSchSettings["idle_unlock"] = false;
+  CrossbarScheduler* xbarSch = new CrossbarScheduler(
+      "XbarSch", nullptr, 3, 3, 3, 0, Simulator::Clock::ROUTER,
+      xbarSchSettings);
+  vcSch->setCreditSource(xbarSch, 0);
+
+  // VC 0 lacks space, VC 1 passes the threshold, VC 2 is an empty buffer
+  //  smaller than the threshold
+  xbarSch->initCredits(0, 4);
+  xbarSch->decrementCredit(0);
+  xbarSch->decrementCredit(0);
+  xbarSch->initCredits(1, 4);
+  xbarSch->decrementCredit(1);
+  xbarSch->initCredits(2, 2);
+
+  CreditMaskTestClient client0(0, vcSch, {0});
+  CreditMaskTestClient client1(1, vcSch, {0, 1});
+  CreditMaskTestClient client2(2, vcSch, {2});
+
+  gSim->initialize();
+  gSim->simulate();
+
+  ASSERT_TRUE(client0.responded());
+  ASSERT_TRUE(client1.responded());
+  ASSERT_TRUE(client2.responded());
+  ASSERT_EQ(client0.response(), U32_MAX);
+  ASSERT_EQ(client1.response(), 1u);
+  ASSERT_EQ(client2.response(), 2u);
+
+  delete vcSch;
+  delete xbarSch;
+}
+
+TEST(VcScheduler, credit_threshold_sources) {
+  TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+  Json::Value arbSettings;
+  arbSettings["type"] = "random";
+  Json::Value allocSettings;
+  allocSettings["type"] = "rc_separable";
+  allocSettings["resource_arbiter"] = arbSettings;
+  allocSettings["client_arbiter"] = arbSettings;
+  allocSettings["iterations"] = 1;
+  allocSettings["slip_latch"] = true;
+  Json::Value schSettings;
+  schSettings["allocator"] = allocSettings;
+  schSettings["credit_threshold"] = 2;
+  VcScheduler* vcSch = new VcScheduler(
+      "VcSch", nullptr, 2, 4, Simulator::Clock::ROUTER, schSettings);
+
+  // each source holds the credits of two VCs (e.g., one per output port)
+  Json::Value xbarSchSettings;
+  xbarSchSettings["allocator"] = allocSettings;
+  xbarSchSettings["full_packet"] = false;
+  xbarSchSettings["packet_lock"] = false;
+  xbarSchSettings["idle_unlock"] = false;
+  CrossbarScheduler* xbarSch0 = new CrossbarScheduler(
+      "XbarSch0", nullptr, 2, 2, 1, 0, Simulator::Clock::ROUTER,
+      xbarSchSettings);
+  CrossbarScheduler* xbarSch1 = new CrossbarScheduler(
+      "XbarSch1", nullptr, 2, 2, 1, 2, Simulator::Clock::ROUTER,
+      xbarSchSettings);
+  vcSch->setCreditSource(xbarSch0, 0);
+  vcSch->setCreditSource(xbarSch1, 2);
+
+  // VC 2 (VC 0 of the second source) lacks space, the others have space
+  for (u32 v = 0; v < 2; v++) {
+    xbarSch0->initCredits(v, 4);
+    xbarSch1->initCredits(v, 4);
+  }
+  xbarSch1->decrementCredit(0);
+  xbarSch1->decrementCredit(0);
+  xbarSch1->decrementCredit(0);
+  ASSERT_TRUE(vcSch->eligible(0));
+  ASSERT_TRUE(vcSch->eligible(1));
+  ASSERT_FALSE(vcSch->eligible(2));
+  ASSERT_TRUE(vcSch->eligible(3));
+
+  CreditMaskTestClient client0(0, vcSch, {0});
+  CreditMaskTestClient client1(1, vcSch, {2, 3});
+
+  gSim->initialize();
+  gSim->simulate();
+
+  ASSERT_EQ(client0.response(), 0u);
+  ASSERT_EQ(client1.response(), 3u);
+
+  delete vcSch;
+  delete xbarSch0;
+  delete xbarSch1;
+}
+
+TEST(VcScheduler, contended) {
+  TestSetup testSetup(1, 1, 1, 0x1234567890abcdf);
+  Json::Value arbSettings;
+  arbSettings["type"] = "random";
+  Json::Value allocSettings;
+  allocSettings["type"] = "rc_separable";
+  allocSettings["resource_arbiter"] = arbSettings;
+  allocSettings["client_arbiter"] = arbSettings;
+  allocSettings["iterations"] = 1;
+  allocSettings["slip_latch"] = true;
+  Json::Value schSettings;
+  schSettings["allocator"] = allocSettings;
+  schSettings["credit_threshold"] = 0;
+  VcScheduler* vcSch = new VcScheduler(
+      "VcSch", nullptr, 3, 2, Simulator::Clock::ROUTER, schSettings);
+
+  // client 0 takes VC 0, later client 1 is denied VC 0 and client 2 gets VC 1
+  u64 later = 2 * gSim->cycleTime(Simulator::Clock::ROUTER);
+  CreditMaskTestClient client0(0, vcSch, {0});
+  CreditMaskTestClient client1(1, vcSch, {0}, later);
+  CreditMaskTestClient client2(2, vcSch, {1}, later);
+
+  gSim->initialize();
+  gSim->simulate();
+
+  ASSERT_EQ(client0.response(), 0u);
+  ASSERT_EQ(client1.response(), U32_MAX);
+  ASSERT_EQ(client2.response(), 1u);
+  ASSERT_TRUE(vcSch->contended(0, 0));
+  ASSERT_FALSE(vcSch->contended(0, 1));
+  ASSERT_FALSE(vcSch->contended(1, 0));
+
+  delete vcSch;
+}
@@ -87,25 +87,35 @@ void BufferOccupancy::initCredits(u32 _vcIdx, u32 _credits) {
 }
 
 void BufferOccupancy::incrementCredit(u32 _vcIdx) {
-  createEvent(_vcIdx, INCR);
+  createEvent(_vcIdx, 1, INCR);
 }
 
 void BufferOccupancy::decrementCredit(u32 _vcIdx) {
-  createEvent(_vcIdx, DECR);
+  createEvent(_vcIdx, 1, DECR);
+}
+
+void BufferOccupancy::incrementCredits(u32 _vcIdx, u32 _credits) {
+  createEvent(_vcIdx, _credits, INCR);
+}
+
+void BufferOccupancy::decrementCredits(u32 _vcIdx, u32 _credits) {
+  createEvent(_vcIdx, _credits, DECR);
 }
 
 void BufferOccupancy::processEvent(void* _event, s32 _type) {
   assert(gSim->epsilon() > 0);
-  u32 vcIdx = static_cast<u32>(reinterpret_cast<u64>(_event));
+  u64 payload = reinterpret_cast<u64>(_event);
+  u32 vcIdx = (u32)(payload & U32_MAX);
+  u32 credits = (u32)(payload >> 32);
   switch (_type) {
     case INCR:
-      performIncrementCredit(vcIdx);
+      performIncrementCredit(vcIdx, credits);
       break;
     case DECR:
-      performDecrementCredit(vcIdx);
+      performDecrementCredit(vcIdx, credits);
       break;
     case PHANTOM:
-      performDecrementWindow(vcIdx);
+      performDecrementWindow(vcIdx, credits);
       break;
     default:
       assert(false);
@@ -202,39 +212,44 @@ BufferOccupancy::Mode BufferOccupancy::parseMode(const std::string& _mode) {
   }
 }
 
-void BufferOccupancy::createEvent(u32 _vcIdx, s32 _type) {
+void BufferOccupancy::createEvent(u32 _vcIdx, u32 _credits, s32 _type) {
   assert(gSim->epsilon() > 0);
+  assert(_credits > 0);
   u64 time = latency_ == 1 ? gSim->time() :
              gSim->futureCycle(Simulator::Clock::ROUTER, latency_ - 1);
-  addEvent(time, gSim->epsilon() + 1, reinterpret_cast<void*>(_vcIdx), _type);
+  u64 payload = ((u64)_credits << 32) | _vcIdx;
+  addEvent(time, gSim->epsilon() + 1, reinterpret_cast<void*>(payload),
+           _type);
 }
 
-void BufferOccupancy::performIncrementCredit(u32 _vcIdx) {
-  assert(creditCounts_.at(_vcIdx) < creditMaximums_.at(_vcIdx));
-  creditCounts_.at(_vcIdx)++;
-  flitsOutstanding_.at(_vcIdx)--;
+void BufferOccupancy::performIncrementCredit(u32 _vcIdx, u32 _credits) {
+  assert(_credits <= creditMaximums_.at(_vcIdx) - creditCounts_.at(_vcIdx));
+  creditCounts_.at(_vcIdx) += _credits;
+  flitsOutstanding_.at(_vcIdx) -= _credits;
 }
 
-void BufferOccupancy::performDecrementCredit(u32 _vcIdx) {
-  assert(creditCounts_.at(_vcIdx) > 0);
-  creditCounts_.at(_vcIdx)--;
-  flitsOutstanding_.at(_vcIdx)++;
+void BufferOccupancy::performDecrementCredit(u32 _vcIdx, u32 _credits) {
+  assert(creditCounts_.at(_vcIdx) >= _credits);
+  creditCounts_.at(_vcIdx) -= _credits;
+  flitsOutstanding_.at(_vcIdx) += _credits;
 
   if (phantom_) {
-    windows_.at(_vcIdx)++;
+    windows_.at(_vcIdx) += _credits;
     u32 port, vc;
     device_->vcIndexInv(_vcIdx, &port, &vc);
     Channel* ch = device_->getOutputChannel(port);
     u32 windowLength = (u32)(ch->latency() * lengthCoeff_);
     u64 time = gSim->futureCycle(Simulator::Clock::CHANNEL, windowLength);
-    addEvent(time, gSim->epsilon(), reinterpret_cast<void*>(_vcIdx), PHANTOM);
+    u64 payload = ((u64)_credits << 32) | _vcIdx;
+    addEvent(time, gSim->epsilon(), reinterpret_cast<void*>(payload),
+             PHANTOM);
   }
 }
 
-void BufferOccupancy::performDecrementWindow(u32 _vcIdx) {
+void BufferOccupancy::performDecrementWindow(u32 _vcIdx, u32 _credits) {
   assert(phantom_);
-  assert(windows_.at(_vcIdx) > 0);
-  windows_.at(_vcIdx)--;
+  assert(windows_.at(_vcIdx) >= _credits);
+  windows_.at(_vcIdx) -= _credits;
 }
 
 f64 BufferOccupancy::vcStatusNorm(u32 _outputPort, u32 _outputVc) const {
@@ -33,6 +33,8 @@ class BufferOccupancy : public CongestionSensor {
   void initCredits(u32 _vcIdx, u32 _credits) override;  // called per source
   void incrementCredit(u32 _vcIdx) override;  // a credit came from downstream
   void decrementCredit(u32 _vcIdx) override;  // a credit was consumed locally
+  void incrementCredits(u32 _vcIdx, u32 _credits) override;
+  void decrementCredits(u32 _vcIdx, u32 _credits) override;
 
   // this creates INCR and DECR events to simulate a fixed latency between all
   //  input and output ports (IOW, input port and VC are ignored in the calc).
@@ -53,10 +55,11 @@ class BufferOccupancy : public CongestionSensor {
 
   static Mode parseMode(const std::string& _mode);
 
-  void createEvent(u32 _vcIdx, s32 _type);
-  void performIncrementCredit(u32 _vcIdx);
-  void performDecrementCredit(u32 _vcIdx);
-  void performDecrementWindow(u32 _vcIdx);
+  // the event of a VC carries its number of credits
+  void createEvent(u32 _vcIdx, u32 _credits, s32 _type);
+  void performIncrementCredit(u32 _vcIdx, u32 _credits);
+  void performDecrementCredit(u32 _vcIdx, u32 _credits);
+  void performDecrementWindow(u32 _vcIdx, u32 _credits);
 
   f64 vcStatusNorm(u32 _outputPort, u32 _outputVc) const;
   f64 vcStatusAbs(u32 _outputPort, u32 _outputVc) const;
@@ -363,6 +363,8 @@ TEST(BufferOccupancy, phantomNormVc) {
 
         Json::Value channelSettings;
         channelSettings["latency"] = channelLatency;
+        channelSettings["width"] = 1;
+        channelSettings["slotted"] = false;
         Channel channel("Channel", nullptr, 8, channelSettings);
         router.setOutputChannel(0, &channel);
 
@@ -438,6 +440,8 @@ TEST(BufferOccupancy, phantomAbsVc) {
 
         Json::Value channelSettings;
         channelSettings["latency"] = channelLatency;
+        channelSettings["width"] = 1;
+        channelSettings["slotted"] = false;
         Channel channel("Channel", nullptr, 8, channelSettings);
         router.setOutputChannel(0, &channel);
 
@@ -489,3 +493,83 @@ TEST(BufferOccupancy, phantomAbsVc) {
     }
   }
 }
+
+TEST(BufferOccupancy, bulkCredits) {
+  TestSetup test(1, 1, 1, 1234);
+
+  const bool debug = false;
+  const u32 numPorts = 5;
+  const u32 numVcs = 4;
+  const u32 latency = 8;
+  const u32 granularity = 0;
+
+  Json::Value routerSettings;
+  CongestionTestRouter router(
+      "Router", nullptr, nullptr, 0, {}, numPorts, numVcs, {}, nullptr,
+      routerSettings);
+  router.setDebug(debug);
+
+  Json::Value sensorSettings;
+  sensorSettings["latency"] = latency;
+  sensorSettings["granularity"] = granularity;
+  sensorSettings["mode"] = "normalized_vc";
+  sensorSettings["minimum"] = 0;
+  sensorSettings["offset"] = 0;
+  BufferOccupancy sensor("CongestionSensor", &router, &router,
+                         sensorSettings);
+  sensor.setDebug(debug);
+
+  for (u32 port = 0; port < numPorts; port++) {
+    for (u32 vc = 0; vc < numVcs; vc++) {
+      u32 max = port * 10 + vc + 2;
+      sensor.initCredits(router.vcIndex(port, vc), max);
+    }
+  }
+
+  CreditHandler crediter("CreditHandler", nullptr, &sensor, &router);
+  crediter.setDebug(debug);
+
+  StatusCheck check("StatusCheck", nullptr, &sensor);
+  check.setDebug(debug);
+
+  // consume all but one credit of each VC at once
+  u64 time = 1000;
+  for (u32 port = 0; port < numPorts; port++) {
+    for (u32 vc = 0; vc < numVcs; vc++) {
+      u32 max = port * 10 + vc + 2;
+      crediter.setEvent(port, vc, time, 1, CreditHandler::Type::DECR,
+                        max - 1);
+      time++;
+    }
+  }
+
+  time = 10000;
+  for (u32 port = 0; port < numPorts; port++) {
+    for (u32 vc = 0; vc < numVcs; vc++) {
+      u32 max = port * 10 + vc + 2;
+      f64 exp = (f64)(max - 1) / (f64)max;
+      check.setEvent(time, 0, 0, 0, port, vc, exp);
+    }
+  }
+
+  // return them at once, the sensor checks all credits are back at the end
+  time = 100000;
+  for (u32 port = 0; port < numPorts; port++) {
+    for (u32 vc = 0; vc < numVcs; vc++) {
+      u32 max = port * 10 + vc + 2;
+      crediter.setEvent(port, vc, time, 1, CreditHandler::Type::INCR,
+                        max - 1);
+      time++;
+    }
+  }
+
+  time = 200000;
+  for (u32 port = 0; port < numPorts; port++) {
+    for (u32 vc = 0; vc < numVcs; vc++) {
+      check.setEvent(time, 0, 0, 0, port, vc, 0.0);
+    }
+  }
+
+  gSim->initialize();
+  gSim->simulate();
+}
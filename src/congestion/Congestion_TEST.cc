@@ -91,8 +91,9 @@ CreditHandler::CreditHandler(
 CreditHandler::~CreditHandler() {}
 
 void CreditHandler::setEvent(u32 _port, u32 _vc, u64 _time, u8 _epsilon,
-                             CreditHandler::Type _type) {
-  CreditHandler::Event* evt = new CreditHandler::Event({_type, _port, _vc});
+                             CreditHandler::Type _type, u32 _credits) {
+  CreditHandler::Event* evt = new CreditHandler::Event(
+      {_type, _port, _vc, _credits});
   addEvent(_time, _epsilon, evt, 0);
 }
 
@@ -102,12 +103,20 @@ void CreditHandler::processEvent(void* _event, s32 _type) {
   switch (evt->type) {
     case CreditHandler::Type::INCR:
       dbgprintf("incrementing port=%u vc=%u", evt->port, evt->vc);
-      congestionSensor_->incrementCredit(vcIdx);
+      if (evt->credits == 1) {
+        congestionSensor_->incrementCredit(vcIdx);
+      } else {
+        congestionSensor_->incrementCredits(vcIdx, evt->credits);
+      }
       break;
 
     case CreditHandler::Type::DECR:
       dbgprintf("decrementing port=%u vc=%u", evt->port, evt->vc);
-      congestionSensor_->decrementCredit(vcIdx);
+      if (evt->credits == 1) {
+        congestionSensor_->decrementCredit(vcIdx);
+      } else {
+        congestionSensor_->decrementCredits(vcIdx, evt->credits);
+      }
       break;
 
     default:
@@ -70,8 +70,9 @@ class CreditHandler : public Component {
                 CongestionSensor* _congestionSensor, PortedDevice* _device);
   ~CreditHandler();
 
+  // more than one credit uses the bulk credit interface
   void setEvent(u32 _port, u32 _vc, u64 _time, u8 _epsilon,
-                CreditHandler::Type _type);
+                CreditHandler::Type _type, u32 _credits = 1);
   void processEvent(void* _event, s32 _type) override;
 
  private:
@@ -79,6 +80,7 @@ class CreditHandler : public Component {
     Type type;
     u32 port;
     u32 vc;
+    u32 credits;
   };
 
   CongestionSensor* congestionSensor_;
@@ -31,6 +31,10 @@ void NullSensor::incrementCredit(u32 _vcIdx) {}
 
 void NullSensor::decrementCredit(u32 _vcIdx) {}
 
+void NullSensor::incrementCredits(u32 _vcIdx, u32 _credits) {}
+
+void NullSensor::decrementCredits(u32 _vcIdx, u32 _credits) {}
+
 CongestionSensor::Style NullSensor::style() const {
   return CongestionSensor::Style::kNull;
 }
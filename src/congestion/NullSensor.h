@@ -33,6 +33,8 @@ class NullSensor : public CongestionSensor {
   void initCredits(u32 _vcIdx, u32 _credits);
   void incrementCredit(u32 _vcIdx);
   void decrementCredit(u32 _vcIdx);
+  void incrementCredits(u32 _vcIdx, u32 _credits);
+  void decrementCredits(u32 _vcIdx, u32 _credits);
 
   // style and mode reporting
   CongestionSensor::Style style() const override;
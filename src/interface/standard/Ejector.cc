@@ -23,6 +23,7 @@ namespace Standard {
 Ejector::Ejector(const std::string& _name, Interface* _interface)
     : Component(_name, _interface), interface_(_interface) {
   lastSetTime_ = U32_MAX;
+  setCount_ = 0;
 }
 
 Ejector::~Ejector() {}
@@ -30,9 +31,13 @@ Ejector::~Ejector() {}
 void Ejector::receiveFlit(u32 _port, Flit* _flit) {
   // this is overkill checking!
   u64 nextTime = gSim->futureCycle(Simulator::Clock::CHANNEL, 1);
-  assert((lastSetTime_ != nextTime) || (lastSetTime_ == U32_MAX));
+  if (lastSetTime_ != nextTime) {
+    lastSetTime_ = nextTime;
+    setCount_ = 0;
+  }
+  setCount_++;
+  assert(setCount_ <= interface_->getOutputChannel(0)->width());
   interface_->sendFlit(0, _flit);
-  lastSetTime_ = nextTime;
 }
 
 }  // namespace Standard
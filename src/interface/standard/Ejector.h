@@ -40,6 +40,7 @@ class Ejector : public Component, public FlitReceiver {
   Interface* interface_;
   u32 portId_;
   u64 lastSetTime_;
+  u32 setCount_;
 };
 
 }  // namespace Standard
@@ -227,11 +227,16 @@ void Interface::initialize() {
     // initialize the credit count in the CrossbarScheduler
     crossbarScheduler_->initCredits(vc, credits);
   }
+
+  // a wide output channel injects a flit per lane each cycle
+  u32 width = outputChannel_->width();
+  crossbarScheduler_->setPortWidth(0, width);
+  crossbar_->setWidth(width);
 }
 
 void Interface::sendFlit(u32 _port, Flit* _flit) {
   assert(_port == 0);
-  assert(outputChannel_->getNextFlit() == nullptr);
+  assert(!outputChannel_->isNextFlitSlotFull());
   outputChannel_->setNextFlit(_flit);
 
   // inform the base class of departure
@@ -279,7 +284,7 @@ void Interface::sendCredit(u32 _port, u32 _vc) {
   // send credit
   Credit* credit = inputChannel_->getNextCredit();
   if (credit == nullptr) {
-    credit = new Credit(numVcs_);
+    credit = new Credit(numVcs_ * inputChannel_->width());
     inputChannel_->setNextCredit(credit);
   }
   credit->putNum(_vc);
@@ -16,6 +16,8 @@
 
 #include <cassert>
 
+#include <algorithm>
+
 #include "interface/standard/Interface.h"
 #include "types/Packet.h"
 
@@ -42,6 +44,7 @@ OutputQueue::OutputQueue(
   // initialize the entry
   swa_.fsm = ePipelineFsm::kEmpty;
   swa_.flit = nullptr;
+  swa_.flits = 0;
 
   // no event is set to trigger
   eventTime_ = U64_MAX;
@@ -97,6 +100,7 @@ void OutputQueue::crossbarSchedulerResponse(u32 _port, u32 _vc) {
     assert(_port == 0);  // only one port here
     assert(_vc == vc_);  // same VC as this
     swa_.fsm = ePipelineFsm::kReadyToAdvance;
+    swa_.flits = crossbarScheduler_->grantedFlits(crossbarSchedulerIndex_);
   } else {
     // denied
     swa_.fsm = ePipelineFsm::kWaitingToRequest;
@@ -124,16 +128,27 @@ void OutputQueue::processPipeline() {
   if (swa_.fsm == ePipelineFsm::kReadyToAdvance) {
     dbgprintf("loading crossbar");
 
-    // send the flit on the crossbar
-    crossbar_->inject(swa_.flit, crossbarIndex_, 0);
-    crossbarScheduler_->decrementCredit(vc_);
+    // send the flits on the crossbar, on a wide channel the following flits
+    //  of the packet may go along
+    assert(swa_.flits > 0);
+    for (u32 f = 0; f < swa_.flits; f++) {
+      Flit* flit = swa_.flit;
+      if (f > 0) {
+        flit = buffer_.front();
+        buffer_.pop();
+        assert(flit->packet() == swa_.flit->packet());
+      }
+      crossbar_->inject(flit, crossbarIndex_, 0);
+      crossbarScheduler_->decrementCredit(vc_);
+
+      // update interface
+      interface_->incrementCredit(vc_);
+    }
 
     // clear SWA info
     swa_.fsm = ePipelineFsm::kEmpty;
     swa_.flit = nullptr;
-
-    // update interface
-    interface_->incrementCredit(vc_);
+    swa_.flits = 0;
   }
 
   /*
@@ -160,9 +175,13 @@ void OutputQueue::processPipeline() {
    * Attempt to submit a SWA request
    */
   if (swa_.fsm == ePipelineFsm::kWaitingToRequest) {
+    // a wide channel can take the queued flits of the packet too, the
+    //  scheduler limits the grant to the channel width
+    u32 remaining = swa_.flit->packet()->numFlits() - swa_.flit->id() - 1;
+    u32 flits = 1 + std::min(remaining, (u32)buffer_.size());
     swa_.fsm = ePipelineFsm::kWaitingForResponse;
     crossbarScheduler_->request(crossbarSchedulerIndex_, 0, vc_,
-                                swa_.flit);
+                                swa_.flit, flits);
   }
 
   // clear the eventTime_ variable to indicate no more events are set
@@ -27,6 +27,7 @@
 #include "event/Simulator.h"
 #include "event/VectorQueue.h"
 #include "metadata/MetadataHandler.h"
+#include "network/FlowModel.h"
 #include "network/Network.h"
 
 s32 main(s32 _argc, char** _argv) {
@@ -75,6 +76,16 @@ s32 main(s32 _argc, char** _argv) {
          numVcs,
          numComponents);
 
+  // analyze the network with the flow model instead of simulating it
+  if (settings.isMember("flow_model")) {
+    printf("Flow model analysis\n");
+    FlowModel::run(network, settings["flow_model"]);
+    delete network;
+    delete metadataHandler;
+    delete gSim;
+    return 0;
+  }
+
   // create the workload
   Workload* workload = new Workload(
       "Workload", nullptr, metadataHandler, settings["workload"]);
@@ -25,24 +25,35 @@
 
 #define FLIT 0xBE
 #define CRDT 0xEF
+#define SLOT 0x5A
 
 Channel::Channel(const std::string& _name, const Component* _parent,
                  u32 _numVcs, Json::Value _settings)
     : Component(_name, _parent),
       latency_(_settings["latency"].asUInt()),
-      numVcs_(_numVcs) {
+      width_(_settings["width"].asUInt()),
+      numVcs_(_numVcs),
+      slotted_(_settings["slotted"].asBool() || (width_ > 1)),
+      slots_(latency_ + 1),
+      flits_(slotted_ ? (latency_ + 1) * width_ : 1),
+      slotEventPending_(false) {
   assert(!_settings["latency"].isNull());
   assert(latency_ > 0);
+  assert(_settings.isMember("width") && _settings["width"].isUInt());
+  assert(width_ > 0);
   assert(numVcs_ > 0);
+  assert(_settings.isMember("slotted") && _settings["slotted"].isBool());
 
   nextFlitTime_ = U64_MAX;
   nextFlit_ = nullptr;
+  nextFlitCount_ = 0;
   nextCreditTime_ = U64_MAX;
   nextCredit_ = nullptr;
 
   monitoring_ = false;
   monitorTime_ = U64_MAX;
   monitorCounts_.resize(_numVcs + 1);
+  windowTime_ = 0;
       }
 
 Channel::~Channel() {}
@@ -51,6 +62,10 @@ u32 Channel::latency() const {
   return latency_;
 }
 
+u32 Channel::width() const {
+  return width_;
+}
+
 void Channel::setSource(CreditReceiver* _source, u32 _port) {
   source_ = _source;
   sourcePort_ = _port;
@@ -61,6 +76,14 @@ void Channel::setSink(FlitReceiver* _sink, u32 _port) {
   sinkPort_ = _port;
 }
 
+FlitReceiver* Channel::getSink() const {
+  return sink_;
+}
+
+u32 Channel::getSinkPort() const {
+  return sinkPort_;
+}
+
 void Channel::startMonitoring() {
   assert(monitoring_ == false);
   assert(monitorTime_ == U64_MAX);
@@ -69,6 +92,7 @@ void Channel::startMonitoring() {
   for (auto& mc : monitorCounts_) {
     mc = 0;
   }
+  windowCounts_.clear();
 }
 
 void Channel::endMonitoring() {
@@ -76,6 +100,11 @@ void Channel::endMonitoring() {
   assert(monitorTime_ != U64_MAX);
   monitoring_ = false;
   monitorTime_ = gSim->time() - monitorTime_;  // delta time
+  if (windowTime_ > 0) {
+    u64 windows = (monitorTime_ + windowTime_ - 1) / windowTime_;
+    assert(windowCounts_.size() <= windows);
+    windowCounts_.resize(windows, 0);
+  }
 }
 
 f64 Channel::utilization(u32 _vc) const {
@@ -89,7 +118,17 @@ f64 Channel::utilization(u32 _vc) const {
     count = monitorCounts_.at(_vc);
   }
   return (f64)count / ((f64)monitorTime_ / gSim->cycleTime(
-      Simulator::Clock::CHANNEL));
+      Simulator::Clock::CHANNEL) * width_);
+}
+
+void Channel::setMonitorWindow(u32 _cycles) {
+  assert(monitoring_ == false);
+  windowTime_ = (u64)_cycles * gSim->cycleTime(Simulator::Clock::CHANNEL);
+}
+
+const std::vector<u32>& Channel::windowCounts() const {
+  assert(monitoring_ == false);
+  return windowCounts_;
 }
 
 void Channel::processEvent(void* _event, s32 _type) {
@@ -107,6 +146,9 @@ void Channel::processEvent(void* _event, s32 _type) {
         source_->receiveCredit(sourcePort_, credit);
       }
       break;
+    case SLOT:
+      deliverSlot();
+      break;
     default:
       assert(false);
   }
@@ -125,24 +167,48 @@ Flit* Channel::getNextFlit() const {
   }
 }
 
+bool Channel::isNextFlitSlotFull() const {
+  // determine the next time slot to send a flit
+  u64 nextSlot = gSim->futureCycle(Simulator::Clock::CHANNEL, 1);
+  return (nextFlitTime_ == nextSlot) && (nextFlitCount_ == width_);
+}
+
 u64 Channel::setNextFlit(Flit* _flit) {
   // determine the next time slot to send a flit
   u64 nextSlot = gSim->futureCycle(Simulator::Clock::CHANNEL, 1);
-  assert(nextSlot != nextFlitTime_);
+  if (nextSlot != nextFlitTime_) {
+    nextFlitCount_ = 0;
+  }
+  assert(nextFlitCount_ < width_);
 
   // set the time and value
   nextFlitTime_ = nextSlot;
   nextFlit_ = _flit;
+  nextFlitCount_++;
 
   // add the event of when the flit will arrive on the other end
   u64 nextTime = gSim->futureCycle(Simulator::Clock::CHANNEL, latency_);
-  addEvent(nextTime, 1, _flit, FLIT);
+  if (slotted_) {
+    Slot& slot = arrivalSlot(nextTime);
+    assert(slot.flits < width_);
+    slot.flits++;
+    flits_.push(_flit);
+  } else {
+    addEvent(nextTime, 1, _flit, FLIT);
+  }
 
   // increment the count when monitoring
   assert(_flit->getVc() < numVcs_);
   if (monitoring_) {
     monitorCounts_.at(_flit->getVc())++;
     monitorCounts_.at(numVcs_)++;
+    if (windowTime_ > 0) {
+      u64 window = (gSim->time() - monitorTime_) / windowTime_;
+      if (window >= windowCounts_.size()) {
+        windowCounts_.resize(window + 1, 0);
+      }
+      windowCounts_[window]++;
+    }
   }
 
   // return the injection time
@@ -173,8 +239,50 @@ u64 Channel::setNextCredit(Credit* _credit) {
 
   // add the event of when the credit will arrive on the other end
   u64 nextTime = gSim->futureCycle(Simulator::Clock::CHANNEL, latency_);
-  addEvent(nextTime, 1, _credit, CRDT);
+  if (slotted_) {
+    Slot& slot = arrivalSlot(nextTime);
+    assert(slot.credit == nullptr);
+    slot.credit = _credit;
+  } else {
+    addEvent(nextTime, 1, _credit, CRDT);
+  }
 
   // return the injection time
   return nextCreditTime_;
 }
+
+Channel::Slot& Channel::arrivalSlot(u64 _time) {
+  // arrival times never decrease, so a new time goes to the back
+  if (slots_.empty() || slots_.back().time != _time) {
+    assert(slots_.empty() || slots_.back().time < _time);
+    slots_.push({_time, 0, nullptr});
+    if (!slotEventPending_) {
+      addEvent(slots_.front().time, 1, nullptr, SLOT);
+      slotEventPending_ = true;
+    }
+  }
+  return slots_.back();
+}
+
+void Channel::deliverSlot() {
+  assert(slotEventPending_);
+  slotEventPending_ = false;
+  Slot slot = slots_.front();
+  assert(slot.time == gSim->time());
+  slots_.pop();
+
+  for (u32 f = 0; f < slot.flits; f++) {
+    Flit* flit = flits_.front();
+    flits_.pop();
+    sink_->receiveFlit(sinkPort_, flit);
+  }
+  if (slot.credit != nullptr) {
+    source_->receiveCredit(sourcePort_, slot.credit);
+  }
+
+  // wait for the next occupied slot
+  if (!slots_.empty() && !slotEventPending_) {
+    addEvent(slots_.front().time, 1, nullptr, SLOT);
+    slotEventPending_ = true;
+  }
+}
@@ -22,34 +22,65 @@
 #include <vector>
 
 #include "event/Component.h"
+#include "util/RingBuffer.h"
 
 class Flit;
 class FlitReceiver;
 class Credit;
 class CreditReceiver;
 
+/*
+ * A channel delivers each flit and credit 'latency' channel cycles after it is
+ *  set. It carries up to 'width' flits and one credit per channel cycle. By
+ *  default every flit and every credit is its own event. In slotted mode the
+ *  in-flight flits and credits are held in a ring of arrival slots (at most
+ *  latency + 1 are occupied) and the channel has a single event pending for
+ *  the earliest occupied slot, which delivers all its flits and its credit.
+ *  Events of the same time have no order, so a wide channel is always slotted
+ *  to deliver the flits of a cycle in the order they were set.
+ */
 class Channel : public Component {
  public:
   Channel(const std::string& _name, const Component* _parent,
           u32 _numVcs, Json::Value _settings);
   ~Channel();
   u32 latency() const;
+  u32 width() const;
   void setSource(CreditReceiver* _source, u32 _port);
   void setSink(FlitReceiver* _sink, u32 _port);
+  FlitReceiver* getSink() const;
+  u32 getSinkPort() const;
   void startMonitoring();
   void endMonitoring();
-  f64 utilization(u32 _vc) const;  // U32_MAX for total
+  f64 utilization(u32 _vc) const;  // U32_MAX for total, relative to width
+
+  /*
+   * While monitoring, the flits set on the channel are also counted in
+   * consecutive windows of '_cycles' channel cycles (0 disables this). The
+   * counts are kept in memory, after monitoring there is one per window
+   * started, the last one might be partial.
+   */
+  void setMonitorWindow(u32 _cycles);
+  const std::vector<u32>& windowCounts() const;
+
   void processEvent(void* _event, s32 _type) override;
 
   /*
    * This retrieves the flit that exists in the event queue for the next
    * flit time in the future. nullptr is returned if it has not been set.
+   * For a wide channel this is the last flit set for that time.
    */
   Flit* getNextFlit() const;
 
+  /*
+   * This returns true when 'width' flits are already set for the next flit
+   * time in the future.
+   */
+  bool isNextFlitSlotFull() const;
+
   /*
    * Sets 'flit' to be the next flit to traverse the channel. This inserts
-   * an event into the event queue. If an existing flit is already set for
+   * an event into the event queue. If 'width' flits are already set for
    * this time, an assertion will fail!
    * This returns the time the flit will be injected into the channel,
    * which is guaranteed to be in the future.
@@ -72,16 +103,35 @@ class Channel : public Component {
   u64 setNextCredit(Credit* _credit);
 
  private:
+  struct Slot {
+    u64 time;
+    u32 flits;  // number of flits in 'flits_'
+    Credit* credit;
+  };
+
+  // returns the slot for an arrival at '_time', adding it if needed
+  Slot& arrivalSlot(u64 _time);
+  void deliverSlot();
+
   const u32 latency_;
+  const u32 width_;
   const u32 numVcs_;
+  const bool slotted_;
+
+  RingBuffer<Slot> slots_;  // in time order
+  RingBuffer<Flit*> flits_;  // flits of the slots in order
+  bool slotEventPending_;
 
   u64 nextFlitTime_;
   Flit* nextFlit_;
+  u32 nextFlitCount_;
   u64 nextCreditTime_;
   Credit* nextCredit_;
   bool monitoring_;
   u64 monitorTime_;
   std::vector<u64> monitorCounts_;
+  u64 windowTime_;  // 0 when disabled
+  std::vector<u32> windowCounts_;
 
   CreditReceiver* source_;  // sends flits, receives credits
   u32 sourcePort_;
@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "event/Component.h"
@@ -209,10 +210,71 @@ class EndMonitoring : public Component {
   Channel* channel_;
 };
 
+/* Wide channels */
+
+class WideSource : public Component {
+ public:
+  explicit WideSource(Channel* _channel)
+      : Component("WideSource", nullptr), channel_(_channel) {
+    channel_->setSource(nullptr, 0);
+  }
+
+  ~WideSource() {}
+
+  // injects '_count' flits at '_cycle'
+  void load(u64 _cycle, u32 _count) {
+    u64 time = gSim->futureCycle(Simulator::Clock::CHANNEL, _cycle);
+    counts_[time] = _count;
+    addEvent(time, 0, nullptr, 0);
+  }
+
+  void processEvent(void* _event, s32 _type) {
+    u32 count = counts_.at(gSim->time());
+    for (u32 f = 0; f < count; f++) {
+      assert(!channel_->isNextFlitSlotFull());
+      Flit* flit = new Flit(0, false, false, nullptr);
+      flit->setVc(f);
+      channel_->setNextFlit(flit);
+    }
+    assert(channel_->isNextFlitSlotFull() == (count == channel_->width()));
+  }
+
+ private:
+  Channel* channel_;
+  std::unordered_map<u64, u32> counts_;
+};
+
+class WideSink : public Component, public FlitReceiver {
+ public:
+  explicit WideSink(Channel* _channel)
+      : Component("WideSink", nullptr) {
+    _channel->setSink(this, 0);
+  }
+
+  ~WideSink() {}
+
+  void processEvent(void* _event, s32 _type) {}
+
+  void receiveFlit(u32 _port, Flit* _flit) {
+    // the flits of a cycle arrive in the order they were set
+    u32& count = counts_[gSim->time()];
+    assert(_flit->getVc() == count);
+    count++;
+    delete _flit;
+  }
+
+  u32 count(u64 _time) const {
+    auto it = counts_.find(_time);
+    return (it == counts_.end()) ? 0 : it->second;
+  }
+
+ private:
+  std::unordered_map<u64, u32> counts_;
+};
 
 /* Test driver */
 
-TEST(Channel, full) {
+static void testChannel(bool _slotted) {
   u64 seed = 12345678;
   for (u32 cycleTime = 1; cycleTime <= 100; cycleTime += 26) {
     TestSetup setup(cycleTime, cycleTime, cycleTime, seed++);
@@ -221,6 +283,8 @@ TEST(Channel, full) {
 
     Json::Value settings;
     settings["latency"] = latency;
+    settings["width"] = 1;
+    settings["slotted"] = _slotted;
     Channel c("TestChannel", nullptr, 8, settings);
 
     Source source(&c);
@@ -245,3 +309,94 @@ TEST(Channel, full) {
     ASSERT_LE(absDelta, 0.0001);
   }
 }
+
+TEST(Channel, full) {
+  testChannel(false);
+}
+
+TEST(Channel, slotted) {
+  testChannel(true);
+}
+
+TEST(Channel, wide) {
+  for (u32 slotted = 0; slotted < 2; slotted++) {
+    TestSetup setup(10, 10, 10, 12345678 + slotted);
+
+    const u32 latency = 3;
+    const u32 width = 4;
+
+    Json::Value settings;
+    settings["latency"] = latency;
+    settings["width"] = width;
+    settings["slotted"] = slotted == 1;
+    Channel c("TestChannel", nullptr, 8, settings);
+    ASSERT_EQ(c.width(), width);
+
+    WideSource source(&c);
+    WideSink sink(&c);
+
+    const u32 clocks = 1000;
+    std::vector<u32> counts(clocks, 0);
+    u64 flits = 0;
+    for (u32 cycle = 1; cycle < clocks; cycle++) {
+      counts.at(cycle) = gSim->rnd.nextU64(0, width);
+      flits += counts.at(cycle);
+      if (counts.at(cycle) > 0) {
+        source.load(cycle, counts.at(cycle));
+      }
+    }
+
+    EndMonitoring ender(&c, clocks);
+
+    gSim->initialize();
+    gSim->simulate();
+
+    for (u32 cycle = 1; cycle < clocks; cycle++) {
+      u64 arrival = (cycle + latency) *
+                    gSim->cycleTime(Simulator::Clock::CHANNEL);
+      ASSERT_EQ(sink.count(arrival), counts.at(cycle));
+    }
+
+    f64 actUtil = c.utilization(U32_MAX);
+    f64 expUtil = static_cast<f64>(flits) / (clocks * width);
+    ASSERT_NEAR(actUtil, expUtil, 0.0001);
+  }
+}
+
+TEST(Channel, windows) {
+  TestSetup setup(10, 10, 10, 12345678);
+
+  const u32 width = 2;
+  const u32 window = 10;
+  const u32 clocks = 95;
+
+  Json::Value settings;
+  settings["latency"] = 2;
+  settings["width"] = width;
+  settings["slotted"] = false;
+  Channel c("TestChannel", nullptr, 8, settings);
+  c.setMonitorWindow(window);
+
+  WideSource source(&c);
+  WideSink sink(&c);
+
+  std::vector<u32> expCounts((clocks + window - 1) / window, 0);
+  for (u32 cycle = 1; cycle < clocks; cycle++) {
+    u32 count = gSim->rnd.nextU64(0, width);
+    if (count > 0) {
+      source.load(cycle, count);
+      expCounts.at(cycle / window) += count;
+    }
+  }
+
+  EndMonitoring ender(&c, clocks);
+
+  gSim->initialize();
+  gSim->simulate();
+
+  const std::vector<u32>& actCounts = c.windowCounts();
+  ASSERT_EQ(actCounts.size(), expCounts.size());
+  for (u32 w = 0; w < expCounts.size(); w++) {
+    ASSERT_EQ(actCounts.at(w), expCounts.at(w));
+  }
+}
@@ -0,0 +1,492 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/FlowModel.h"
+
+#include <fio/InFile.h>
+#include <fio/OutFile.h>
+#include <strop/strop.h>
+
+#include <cassert>
+#include <cstdio>
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+
+#include "interface/Interface.h"
+#include "network/Channel.h"
+#include "network/Network.h"
+#include "router/Router.h"
+#include "types/FlitReceiver.h"
+
+FlowModel::FlowModel()
+    : saturationScale_(F64_POS_INF) {}
+
+FlowModel::~FlowModel() {}
+
+FlowModel::PathMode FlowModel::parsePathMode(const std::string& _mode) {
+  if (_mode == "minimal") {
+    return FlowModel::PathMode::kMinimal;
+  } else if (_mode == "valiant") {
+    return FlowModel::PathMode::kValiant;
+  } else {
+    fprintf(stderr, "invalid flow model path mode: %s\n", _mode.c_str());
+    assert(false);
+  }
+}
+
+void FlowModel::loadNetwork(const Network* _network) {
+  u32 numRouters = _network->numRouters();
+  u32 numInterfaces = _network->numInterfaces();
+
+  // create the nodes, remember which flit receiver each one is
+  std::vector<PortedDevice*> devices;
+  std::unordered_map<const FlitReceiver*, u32> nodes;
+  for (u32 r = 0; r < numRouters; r++) {
+    Router* router = _network->getRouter(r);
+    u32 node = addNode();
+    addIntermediate(node);
+    devices.push_back(router);
+    nodes[router] = node;
+  }
+  for (u32 i = 0; i < numInterfaces; i++) {
+    Interface* interface = _network->getInterface(i);
+    u32 node = addNode();
+    u32 terminal = addTerminal(node);
+    assert(terminal == i);
+    devices.push_back(interface);
+    nodes[interface] = node;
+  }
+
+  // each channel is a link, a channel carries 'width' flits per channel cycle
+  for (u32 node = 0; node < devices.size(); node++) {
+    PortedDevice* device = devices.at(node);
+    for (u32 port = 0; port < device->numPorts(); port++) {
+      Channel* channel = device->getOutputChannel(port);
+      if (channel != nullptr) {
+        u32 sink = nodes.at(channel->getSink());
+        addLink(node, sink, channel->width(), channel->fullName());
+      }
+    }
+  }
+}
+
+u32 FlowModel::addNode() {
+  outLinks_.push_back({});
+  inLinks_.push_back({});
+  distances_.push_back({});
+  nodeFractions_.push_back(0.0);
+  return outLinks_.size() - 1;
+}
+
+u32 FlowModel::addLink(u32 _source, u32 _sink, f64 _capacity,
+                       const std::string& _name) {
+  assert(_source < numNodes());
+  assert(_sink < numNodes());
+  assert(_capacity > 0.0);
+  u32 link = links_.size();
+  links_.push_back({_source, _sink, _capacity, _name});
+  outLinks_.at(_source).push_back(link);
+  inLinks_.at(_sink).push_back(link);
+  linkFractions_.push_back(0.0);
+
+  // the graph changed, distances must be recomputed
+  for (auto& distances : distances_) {
+    distances.clear();
+  }
+  return link;
+}
+
+u32 FlowModel::addTerminal(u32 _node) {
+  assert(_node < numNodes());
+  assert(flows_.empty());
+  terminals_.push_back(_node);
+  return terminals_.size() - 1;
+}
+
+void FlowModel::addIntermediate(u32 _node) {
+  assert(_node < numNodes());
+  intermediates_.push_back(_node);
+}
+
+u32 FlowModel::numNodes() const {
+  return outLinks_.size();
+}
+
+u32 FlowModel::numLinks() const {
+  return links_.size();
+}
+
+u32 FlowModel::numTerminals() const {
+  return terminals_.size();
+}
+
+void FlowModel::setDemand(u32 _source, u32 _destination, f64 _rate) {
+  assert(_source < numTerminals());
+  assert(_destination < numTerminals());
+  assert(_rate >= 0.0);
+  if (flowIndex_.empty()) {
+    flowIndex_.resize(numTerminals() * numTerminals(), U32_MAX);
+  }
+
+  u32& index = flowIndex_.at(_source * numTerminals() + _destination);
+  if (index == U32_MAX) {
+    index = flows_.size();
+    flows_.push_back({_source, _destination, 0.0, 0.0, {}});
+  }
+  flows_.at(index).demand = _rate;
+}
+
+void FlowModel::loadMatrix(const std::string& _filename, f64 _injectionRate) {
+  fio::InFile inf(_filename);
+  std::string line;
+  u32 source = 0;
+  fio::InFile::Status sts = fio::InFile::Status::OK;
+  while (sts == fio::InFile::Status::OK) {
+    sts = inf.getLine(&line);
+    assert(sts != fio::InFile::Status::ERROR);
+    if ((sts == fio::InFile::Status::OK) && (line.size() > 0)) {
+      assert(source < numTerminals());
+      std::vector<std::string> strs = strop::split(line, ',');
+      assert(strs.size() == numTerminals());
+
+      // each row is a probability distribution of destinations
+      std::vector<f64> pdist(strs.size());
+      f64 sum = 0.0;
+      for (u32 idx = 0; idx < strs.size(); idx++) {
+        pdist.at(idx) = std::stod(strs.at(idx));
+        assert(pdist.at(idx) >= 0.0);
+        sum += pdist.at(idx);
+      }
+      if (sum > 0.0) {
+        for (u32 idx = 0; idx < pdist.size(); idx++) {
+          if (pdist.at(idx) > 0.0) {
+            setDemand(source, idx, _injectionRate * pdist.at(idx) / sum);
+          }
+        }
+      }
+      source++;
+    }
+  }
+  if (source != numTerminals()) {
+    fprintf(stderr, "expected %u lines, processed %u lines\n",
+            numTerminals(), source);
+    assert(false);
+  }
+}
+
+void FlowModel::solve(PathMode _mode) {
+  // spread every flow over its paths
+  for (Flow& flow : flows_) {
+    computePaths(&flow, _mode);
+  }
+
+  // the load at full demand determines the saturation point
+  std::vector<f64> demandLoads(numLinks(), 0.0);
+  for (const Flow& flow : flows_) {
+    for (const auto& lf : flow.links) {
+      demandLoads.at(lf.first) += flow.demand * lf.second;
+    }
+  }
+  saturationScale_ = F64_POS_INF;
+  for (u32 link = 0; link < numLinks(); link++) {
+    if (demandLoads.at(link) > 0.0) {
+      saturationScale_ = std::min(
+          saturationScale_, links_.at(link).capacity / demandLoads.at(link));
+    }
+  }
+
+  // max-min fair rates
+  fill();
+}
+
+f64 FlowModel::flowRate(u32 _source, u32 _destination) const {
+  if (flowIndex_.empty()) {
+    return 0.0;
+  }
+  u32 index = flowIndex_.at(_source * numTerminals() + _destination);
+  return (index == U32_MAX) ? 0.0 : flows_.at(index).rate;
+}
+
+f64 FlowModel::linkLoad(u32 _link) const {
+  return loads_.at(_link);
+}
+
+f64 FlowModel::linkUtilization(u32 _link) const {
+  return loads_.at(_link) / links_.at(_link).capacity;
+}
+
+const std::string& FlowModel::linkName(u32 _link) const {
+  return links_.at(_link).name;
+}
+
+f64 FlowModel::offered() const {
+  f64 total = 0.0;
+  for (const Flow& flow : flows_) {
+    total += flow.demand;
+  }
+  return total;
+}
+
+f64 FlowModel::accepted() const {
+  f64 total = 0.0;
+  for (const Flow& flow : flows_) {
+    total += flow.rate;
+  }
+  return total;
+}
+
+f64 FlowModel::saturationScale() const {
+  return saturationScale_;
+}
+
+void FlowModel::run(const Network* _network, Json::Value _settings) {
+  assert(_settings.isMember("traffic_matrix") &&
+         _settings["traffic_matrix"].isString());
+  assert(_settings.isMember("injection_rate") &&
+         _settings["injection_rate"].isDouble());
+  assert(_settings.isMember("paths") && _settings["paths"].isString());
+  f64 injectionRate = _settings["injection_rate"].asDouble();
+  assert(injectionRate > 0.0);
+
+  FlowModel model;
+  model.loadNetwork(_network);
+  model.loadMatrix(_settings["traffic_matrix"].asString(), injectionRate);
+  model.solve(parsePathMode(_settings["paths"].asString()));
+
+  f64 maxUtilization = 0.0;
+  f64 meanUtilization = 0.0;
+  for (u32 link = 0; link < model.numLinks(); link++) {
+    maxUtilization = std::max(maxUtilization, model.linkUtilization(link));
+    meanUtilization += model.linkUtilization(link);
+  }
+  meanUtilization /= model.numLinks();
+
+  u32 terminals = model.numTerminals();
+  printf("Offered:          %f flits/cycle/terminal\n"
+         "Accepted:         %f flits/cycle/terminal\n"
+         "Saturation:       %f flits/cycle/terminal\n"
+         "Max utilization:  %f\n"
+         "Mean utilization: %f\n",
+         model.offered() / terminals,
+         model.accepted() / terminals,
+         model.saturationScale() * injectionRate,
+         maxUtilization,
+         meanUtilization);
+
+  // per link utilization
+  if (_settings.isMember("link_file") && !_settings["link_file"].isNull()) {
+    fio::OutFile outFile(_settings["link_file"].asString());
+    std::stringstream ss;
+    ss.precision(6);
+    ss.setf(std::ios::fixed, std::ios::floatfield);
+    ss << "name,load,utilization" << std::endl;
+    for (u32 link = 0; link < model.numLinks(); link++) {
+      ss << model.linkName(link) << ',' << model.linkLoad(link) << ','
+         << model.linkUtilization(link) << std::endl;
+    }
+    outFile.write(ss.str());
+  }
+}
+
+const std::vector<u32>& FlowModel::distances(u32 _node) {
+  std::vector<u32>& distances = distances_.at(_node);
+  if (distances.empty()) {
+    // breadth first search backwards from the node
+    distances.resize(numNodes(), U32_MAX);
+    distances.at(_node) = 0;
+    std::vector<u32> layer = {_node};
+    std::vector<u32> next;
+    while (!layer.empty()) {
+      for (u32 node : layer) {
+        for (u32 link : inLinks_.at(node)) {
+          u32 source = links_.at(link).source;
+          if (distances.at(source) == U32_MAX) {
+            distances.at(source) = distances.at(node) + 1;
+            next.push_back(source);
+          }
+        }
+      }
+      layer.swap(next);
+      next.clear();
+    }
+  }
+  return distances;
+}
+
+void FlowModel::addMinimalPaths(u32 _source, u32 _sink, f64 _scale) {
+  if (_source == _sink) {
+    return;
+  }
+  const std::vector<u32>& distances = this->distances(_sink);
+  if (distances.at(_source) == U32_MAX) {
+    fprintf(stderr, "node %u can't reach node %u\n", _source, _sink);
+    assert(false);
+  }
+
+  // push the fraction layer by layer towards the sink, each node splits its
+  //  fraction evenly over the links that get one hop closer
+  std::vector<u32> layer = {_source};
+  std::vector<u32> next;
+  nodeFractions_.at(_source) = _scale;
+  while (!layer.empty()) {
+    for (u32 node : layer) {
+      f64 fraction = nodeFractions_.at(node);
+      nodeFractions_.at(node) = 0.0;
+      u32 distance = distances.at(node);
+      if (distance == 0) {
+        continue;  // arrived
+      }
+
+      u32 hops = 0;
+      for (u32 link : outLinks_.at(node)) {
+        if (distances.at(links_.at(link).sink) == distance - 1) {
+          hops++;
+        }
+      }
+      f64 share = fraction / hops;
+      for (u32 link : outLinks_.at(node)) {
+        u32 sink = links_.at(link).sink;
+        if (distances.at(sink) == distance - 1) {
+          if (linkFractions_.at(link) == 0.0) {
+            touchedLinks_.push_back(link);
+          }
+          linkFractions_.at(link) += share;
+          if (nodeFractions_.at(sink) == 0.0) {
+            next.push_back(sink);
+          }
+          nodeFractions_.at(sink) += share;
+        }
+      }
+    }
+    layer.swap(next);
+    next.clear();
+  }
+}
+
+void FlowModel::computePaths(Flow* _flow, PathMode _mode) {
+  u32 source = terminals_.at(_flow->source);
+  u32 destination = terminals_.at(_flow->destination);
+
+  switch (_mode) {
+    case FlowModel::PathMode::kMinimal:
+      if (source == destination) {
+        // traffic to self leaves and comes back through the attached router
+        const std::vector<u32>& outLinks = outLinks_.at(source);
+        assert(!outLinks.empty());
+        f64 share = 1.0 / outLinks.size();
+        for (u32 link : outLinks) {
+          if (linkFractions_.at(link) == 0.0) {
+            touchedLinks_.push_back(link);
+          }
+          linkFractions_.at(link) += share;
+          addMinimalPaths(links_.at(link).sink, destination, share);
+        }
+      } else {
+        addMinimalPaths(source, destination, 1.0);
+      }
+      break;
+
+    case FlowModel::PathMode::kValiant:
+      {
+        assert(!intermediates_.empty());
+        f64 share = 1.0 / intermediates_.size();
+        for (u32 intermediate : intermediates_) {
+          addMinimalPaths(source, intermediate, share);
+          addMinimalPaths(intermediate, destination, share);
+        }
+      }
+      break;
+
+    default:
+      assert(false);
+  }
+
+  // move the fractions into the flow and clear the scratch space
+  _flow->links.clear();
+  std::sort(touchedLinks_.begin(), touchedLinks_.end());
+  for (u32 link : touchedLinks_) {
+    _flow->links.push_back({link, linkFractions_.at(link)});
+    linkFractions_.at(link) = 0.0;
+  }
+  touchedLinks_.clear();
+}
+
+void FlowModel::fill() {
+  const f64 kEpsilon = 1e-12;
+  loads_.assign(numLinks(), 0.0);
+  for (Flow& flow : flows_) {
+    flow.rate = 0.0;
+  }
+
+  // all flows with demand start active
+  std::vector<u32> active;
+  for (u32 f = 0; f < flows_.size(); f++) {
+    if (flows_.at(f).demand > 0.0) {
+      active.push_back(f);
+    }
+  }
+
+  // progressive filling: raise the active flows equally until a demand is met
+  //  or a link saturates, then freeze the affected flows
+  std::vector<f64> growth(numLinks());
+  std::vector<bool> saturated(numLinks(), false);
+  while (!active.empty()) {
+    std::fill(growth.begin(), growth.end(), 0.0);
+    f64 step = F64_POS_INF;
+    for (u32 f : active) {
+      const Flow& flow = flows_.at(f);
+      step = std::min(step, flow.demand - flow.rate);
+      for (const auto& lf : flow.links) {
+        growth.at(lf.first) += lf.second;
+      }
+    }
+    for (u32 link = 0; link < numLinks(); link++) {
+      if (growth.at(link) > 0.0) {
+        f64 residual = links_.at(link).capacity - loads_.at(link);
+        step = std::min(step, std::max(0.0, residual) / growth.at(link));
+      }
+    }
+
+    // raise the rates
+    for (u32 f : active) {
+      Flow& flow = flows_.at(f);
+      flow.rate += step;
+      for (const auto& lf : flow.links) {
+        loads_.at(lf.first) += step * lf.second;
+      }
+    }
+    for (u32 link = 0; link < numLinks(); link++) {
+      f64 capacity = links_.at(link).capacity;
+      saturated.at(link) = (growth.at(link) > 0.0) &&
+                           (loads_.at(link) >= capacity * (1.0 - 1e-9));
+    }
+
+    // freeze the flows that are satisfied or cross a saturated link
+    std::vector<u32> stillActive;
+    for (u32 f : active) {
+      const Flow& flow = flows_.at(f);
+      bool frozen = flow.rate >= flow.demand - kEpsilon;
+      for (const auto& lf : flow.links) {
+        frozen = frozen || saturated.at(lf.first);
+      }
+      if (!frozen) {
+        stillActive.push_back(f);
+      }
+    }
+    assert(stillActive.size() < active.size());
+    active.swap(stillActive);
+  }
+}
@@ -0,0 +1,133 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_FLOWMODEL_H_
+#define NETWORK_FLOWMODEL_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class Network;
+
+/*
+ * This is a flow-level (fluid) model of a network. It analyzes the channel
+ *  graph built by a Network instead of simulating it. Each source/destination
+ *  pair of terminals is a flow with a demand in flits per cycle. Each flow is
+ *  spread over its paths with fixed per-channel fractions given by the path
+ *  mode:
+ *   minimal - at each node, split evenly over the next hops of minimal paths
+ *   valiant - minimal to every intermediate router with equal probability,
+ *             then minimal to the destination
+ *  Flow rates are max-min fair (progressive filling) subject to the channel
+ *  capacities and the demands. The saturation throughput is the injection rate
+ *  at which the most loaded channel reaches its capacity.
+ */
+class FlowModel {
+ public:
+  enum class PathMode {kMinimal, kValiant};
+
+  FlowModel();
+  ~FlowModel();
+
+  static PathMode parsePathMode(const std::string& _mode);
+
+  // builds the channel graph of a network, routers are nodes
+  //  [0,numRouters) and interfaces are the following nodes in id order, they
+  //  are the terminals and the routers are the valiant intermediates
+  void loadNetwork(const Network* _network);
+
+  // graph construction
+  u32 addNode();
+  u32 addLink(u32 _source, u32 _sink, f64 _capacity,
+              const std::string& _name = "");
+  u32 addTerminal(u32 _node);
+  void addIntermediate(u32 _node);
+
+  u32 numNodes() const;
+  u32 numLinks() const;
+  u32 numTerminals() const;
+
+  // demands in flits per cycle between terminals
+  void setDemand(u32 _source, u32 _destination, f64 _rate);
+  // loads a traffic matrix in the format of the 'matrix' traffic pattern, each
+  //  row is the distribution of destinations of a source injecting at
+  //  '_injectionRate' flits per cycle
+  void loadMatrix(const std::string& _filename, f64 _injectionRate);
+
+  // computes the paths and the max-min fair rates
+  void solve(PathMode _mode);
+
+  // results
+  f64 flowRate(u32 _source, u32 _destination) const;
+  f64 linkLoad(u32 _link) const;
+  f64 linkUtilization(u32 _link) const;
+  const std::string& linkName(u32 _link) const;
+  f64 offered() const;  // total demand
+  f64 accepted() const;  // total rate
+  // the demand scale at which the first link saturates (>1 means the demand
+  //  is sustainable)
+  f64 saturationScale() const;
+
+  // runs the model per the settings and prints the results
+  static void run(const Network* _network, Json::Value _settings);
+
+ private:
+  struct Link {
+    u32 source;
+    u32 sink;
+    f64 capacity;
+    std::string name;
+  };
+
+  struct Flow {
+    u32 source;  // terminal
+    u32 destination;  // terminal
+    f64 demand;
+    f64 rate;
+    std::vector<std::pair<u32, f64> > links;  // link, fraction
+  };
+
+  // distances of every node to '_node' in hops (U32_MAX when unreachable)
+  const std::vector<u32>& distances(u32 _node);
+
+  // adds the minimal path fractions from '_source' to '_sink' scaled by
+  //  '_scale' into 'linkFractions_'
+  void addMinimalPaths(u32 _source, u32 _sink, f64 _scale);
+
+  void computePaths(Flow* _flow, PathMode _mode);
+  void fill();
+
+  std::vector<Link> links_;
+  std::vector<std::vector<u32> > outLinks_;
+  std::vector<std::vector<u32> > inLinks_;
+  std::vector<u32> terminals_;
+  std::vector<u32> intermediates_;
+
+  std::vector<Flow> flows_;
+  std::vector<u32> flowIndex_;  // terminal pair to flow, U32_MAX when none
+
+  std::vector<std::vector<u32> > distances_;  // per node, lazily computed
+  std::vector<f64> linkFractions_;  // scratch per link
+  std::vector<u32> touchedLinks_;
+  std::vector<f64> nodeFractions_;  // scratch per node
+
+  std::vector<f64> loads_;
+  f64 saturationScale_;
+};
+
+#endif  // NETWORK_FLOWMODEL_H_
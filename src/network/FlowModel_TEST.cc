@@ -0,0 +1,114 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <prim/prim.h>
+
+#include <vector>
+
+#include "network/FlowModel.h"
+
+#include "gtest/gtest.h"
+
+TEST(FlowModel, maxMinFair) {
+  // two routers with two terminals each, one link between the routers
+  FlowModel model;
+  u32 a = model.addNode();
+  u32 b = model.addNode();
+  std::vector<u32> t;
+  for (u32 i = 0; i < 4; i++) {
+    t.push_back(model.addNode());
+    ASSERT_EQ(model.addTerminal(t.at(i)), i);
+  }
+  model.addLink(t.at(0), a, 1.0);
+  model.addLink(t.at(1), a, 1.0);
+  u32 ab = model.addLink(a, b, 1.0);
+  model.addLink(b, t.at(2), 1.0);
+  model.addLink(b, t.at(3), 1.0);
+  ASSERT_EQ(model.numNodes(), 6u);
+  ASSERT_EQ(model.numLinks(), 5u);
+
+  model.setDemand(0, 2, 0.2);
+  model.setDemand(1, 2, 1.0);
+  model.setDemand(1, 3, 1.0);
+  model.solve(FlowModel::PathMode::kMinimal);
+
+  // the small flow gets its demand, the others share the rest
+  ASSERT_NEAR(model.flowRate(0, 2), 0.2, 1e-9);
+  ASSERT_NEAR(model.flowRate(1, 2), 0.4, 1e-9);
+  ASSERT_NEAR(model.flowRate(1, 3), 0.4, 1e-9);
+  ASSERT_NEAR(model.flowRate(0, 3), 0.0, 1e-9);
+  ASSERT_NEAR(model.linkUtilization(ab), 1.0, 1e-9);
+  ASSERT_NEAR(model.offered(), 2.2, 1e-9);
+  ASSERT_NEAR(model.accepted(), 1.0, 1e-9);
+  ASSERT_NEAR(model.saturationScale(), 1.0 / 2.2, 1e-9);
+}
+
+TEST(FlowModel, minimalSplit) {
+  // a diamond with two equal length paths
+  FlowModel model;
+  u32 s = model.addNode();
+  u32 m0 = model.addNode();
+  u32 m1 = model.addNode();
+  u32 d = model.addNode();
+  model.addTerminal(s);
+  model.addTerminal(d);
+  u32 l0 = model.addLink(s, m0, 1.0);
+  u32 l1 = model.addLink(s, m1, 1.0);
+  u32 l2 = model.addLink(m0, d, 1.0);
+  u32 l3 = model.addLink(m1, d, 2.0);
+  // a longer path that must not be used
+  u32 l4 = model.addLink(m0, m1, 1.0);
+
+  model.setDemand(0, 1, 1.5);
+  model.solve(FlowModel::PathMode::kMinimal);
+
+  ASSERT_NEAR(model.flowRate(0, 1), 1.5, 1e-9);
+  ASSERT_NEAR(model.linkLoad(l0), 0.75, 1e-9);
+  ASSERT_NEAR(model.linkLoad(l1), 0.75, 1e-9);
+  ASSERT_NEAR(model.linkLoad(l2), 0.75, 1e-9);
+  ASSERT_NEAR(model.linkLoad(l3), 0.75, 1e-9);
+  ASSERT_NEAR(model.linkUtilization(l3), 0.375, 1e-9);
+  ASSERT_NEAR(model.linkLoad(l4), 0.0, 1e-9);
+  ASSERT_NEAR(model.saturationScale(), 1.0 / 0.75, 1e-9);
+}
+
+TEST(FlowModel, valiant) {
+  // a bidirectional line of three nodes, all are intermediates
+  FlowModel model;
+  for (u32 i = 0; i < 3; i++) {
+    model.addIntermediate(model.addNode());
+  }
+  model.addTerminal(0);
+  model.addTerminal(1);
+  u32 l01 = model.addLink(0, 1, 1.0);
+  u32 l10 = model.addLink(1, 0, 1.0);
+  u32 l12 = model.addLink(1, 2, 1.0);
+  u32 l21 = model.addLink(2, 1, 1.0);
+
+  model.setDemand(0, 1, 0.6);
+  model.solve(FlowModel::PathMode::kValiant);
+
+  // one third of the traffic detours through node 2
+  ASSERT_NEAR(model.flowRate(0, 1), 0.6, 1e-9);
+  ASSERT_NEAR(model.linkLoad(l01), 0.6, 1e-9);
+  ASSERT_NEAR(model.linkLoad(l10), 0.0, 1e-9);
+  ASSERT_NEAR(model.linkLoad(l12), 0.2, 1e-9);
+  ASSERT_NEAR(model.linkLoad(l21), 0.2, 1e-9);
+
+  // the demand exceeds the capacity of the first link
+  model.setDemand(0, 1, 2.0);
+  model.solve(FlowModel::PathMode::kValiant);
+  ASSERT_NEAR(model.flowRate(0, 1), 1.0, 1e-9);
+  ASSERT_NEAR(model.saturationScale(), 0.5, 1e-9);
+}
@@ -83,6 +83,7 @@ void Network::startMonitoring() {
   collectChannels(&channels);
   for (auto it = channels.begin(); it != channels.end(); ++it) {
     Channel* c = *it;
+    c->setMonitorWindow(channelLog_->window());
     c->startMonitoring();
   }
 }
@@ -26,9 +26,10 @@ namespace Butterfly {
 DestTagRoutingAlgorithm::DestTagRoutingAlgorithm(
     const std::string& _name, const Component* _parent, Router* _router,
     u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc, u32 _numPorts,
-    u32 _numStages, u32 _stage, Json::Value _settings)
+    u32 _numStages, u32 _numPasses, u32 _stage, Json::Value _settings)
     : RoutingAlgorithm(_name, _parent, _router, _baseVc, _numVcs, _inputPort,
-                       _inputVc, _numPorts, _numStages, _stage, _settings) {}
+                       _inputVc, _numPorts, _numStages, _numPasses, _stage,
+                       _settings) {}
 
 DestTagRoutingAlgorithm::~DestTagRoutingAlgorithm() {}
 
@@ -38,8 +39,9 @@ void DestTagRoutingAlgorithm::processRequest(
       _flit->packet()->message()->getDestinationAddress();
   assert(destinationAddress->size() == numStages_);
 
-  // pick the output port using the "tag" in the address
-  u32 outputPort = destinationAddress->at(stage_);
+  // pick the output port using the "tag" in the address, every pass uses the
+  //  same tag
+  u32 outputPort = destinationAddress->at(stage_ % numStages_);
 
   // select all VCs in the output port
   for (u32 vc = baseVc_; vc < baseVc_ + numVcs_; vc++) {
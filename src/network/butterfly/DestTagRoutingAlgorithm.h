@@ -32,7 +32,7 @@ class DestTagRoutingAlgorithm : public RoutingAlgorithm {
   DestTagRoutingAlgorithm(
       const std::string& _name, const Component* _parent, Router* _router,
       u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc, u32 _numPorts,
-      u32 _numStages, u32 _stage, Json::Value _settings);
+      u32 _numStages, u32 _numPasses, u32 _stage, Json::Value _settings);
   ~DestTagRoutingAlgorithm();
 
  protected:
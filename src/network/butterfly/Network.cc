@@ -37,12 +37,17 @@ Network::Network(const std::string& _name, const Component* _parent,
   assert(numStages_ >= 1);
   stageWidth_ = (u32)pow(routerRadix_, numStages_ - 1);
 
+  // passes through the butterfly, each pass has 'numStages_' stages
+  numPasses_ = _settings["passes"].asUInt();
+  assert(numPasses_ >= 1);
+  const u32 totalStages = numStages_ * numPasses_;
+
   // parse the protocol classes description
   loadProtocolClassInfo(_settings["protocol_classes"]);
 
   // create the routers
-  routers_.resize(stageWidth_ * numStages_, nullptr);
-  for (u32 stage = 0; stage < numStages_; stage++) {
+  routers_.resize(stageWidth_ * totalStages, nullptr);
+  for (u32 stage = 0; stage < totalStages; stage++) {
     tmpStage_ = stage;
     for (u32 column = 0; column < stageWidth_; column++) {
       // create the router name
@@ -58,26 +63,43 @@ Network::Network(const std::string& _name, const Component* _parent,
   }
 
   // create internal channels, link routers via channels
-  for (u32 cStage = 0; cStage < numStages_ - 1; cStage++) {
-    u32 cBaseUnit = (u32)pow(routerRadix_, numStages_ - 1 - cStage);
+  for (u32 cStage = 0; cStage < totalStages - 1; cStage++) {
+    // the butterfly pattern is repeated in each pass
+    u32 cPassStage = cStage % numStages_;
+    bool lastStage = cPassStage == numStages_ - 1;
+    u32 cBaseUnit = (u32)pow(routerRadix_, numStages_ - 1 - cPassStage);
     u32 nStage = cStage + 1;
-    u32 nBaseUnit = (u32)pow(routerRadix_, numStages_ - 1 - nStage);
+    u32 nBaseUnit = lastStage ? 1 :
+        (u32)pow(routerRadix_, numStages_ - 1 - (cPassStage + 1));
     for (u32 cColumn = 0; cColumn < stageWidth_; cColumn++) {
       u32 sourceId = cStage * stageWidth_ + cColumn;
       Router* sourceRouter = routers_.at(sourceId);
       u32 cBaseOffset = (cColumn / cBaseUnit) * cBaseUnit;
       u32 cBaseIndex = cColumn % cBaseUnit;
       for (u32 cOutputPort = 0; cOutputPort < routerRadix_; cOutputPort++) {
-        u32 nColumn = cBaseOffset + (cBaseIndex % nBaseUnit) +
-                      (cOutputPort * nBaseUnit);
+        u32 nColumn;
+        u32 nInputPort;
+        if (lastStage) {
+          // the end of a pass connects to the start of the next pass just as
+          //  the interfaces would connect
+          nColumn = cColumn;
+          nInputPort = cOutputPort;
+        } else {
+          nColumn = cBaseOffset + (cBaseIndex % nBaseUnit) +
+                    (cOutputPort * nBaseUnit);
+          nInputPort = cBaseIndex / nBaseUnit;  // cBaseIndex / routerRadix_;
+        }
         u32 destinationId = nStage * stageWidth_ + nColumn;
         Router* destinationRouter = routers_.at(destinationId);
-        u32 nInputPort = cBaseIndex / nBaseUnit;  // cBaseIndex / routerRadix_;
 
         // create channel
         std::string chname =
             "Channel_" + strop::vecString<u32>(sourceRouter->address(), '-') +
             "-to-" + strop::vecString<u32>(destinationRouter->address(), '-');
+        if (lastStage) {
+          // routers between passes are linked on every port
+          chname += "_" + std::to_string(cOutputPort);
+        }
         Channel* channel = new Channel(chname, this, numVcs_,
                                        _settings["internal_channel"]);
         internalChannels_.push_back(channel);
@@ -106,7 +128,7 @@ Network::Network(const std::string& _name, const Component* _parent,
     u32 routerIndex = id / routerRadix_;
     u32 routerPort = id % routerRadix_;
     u32 inputRouterId = 0 * stageWidth_ + routerIndex;
-    u32 outputRouterId = (numStages_ - 1) * stageWidth_ + routerIndex;
+    u32 outputRouterId = (totalStages - 1) * stageWidth_ + routerIndex;
     Router* inputRouter = routers_.at(inputRouterId);
     Router* outputRouter = routers_.at(outputRouterId);
 
@@ -162,11 +184,11 @@ Network::~Network() {
   // call the routing algorithm factory
   return RoutingAlgorithm::create(
       _name, _parent, _router, info.baseVc, info.numVcs, _inputPort, _inputVc,
-      routerRadix_, numStages_, tmpStage_, info.settings);
+      routerRadix_, numStages_, numPasses_, tmpStage_, info.settings);
 }
 
 u32 Network::numRouters() const {
-  return stageWidth_ * numStages_;
+  return stageWidth_ * numStages_ * numPasses_;
 }
 
 u32 Network::numInterfaces() const {
@@ -207,7 +229,7 @@ u32 Network::translateRouterAddressToId(
 
 u32 Network::computeMinimalHops(const std::vector<u32>* _source,
                                 const std::vector<u32>* _destination) const {
-  return Butterfly::computeMinimalHops(numStages_);
+  return Butterfly::computeMinimalHops(numStages_ * numPasses_);
 }
 
 void Network::collectChannels(std::vector<Channel*>* _channels) {
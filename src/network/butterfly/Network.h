@@ -62,6 +62,7 @@ class Network : public ::Network {
  private:
   u32 routerRadix_;
   u32 numStages_;
+  u32 numPasses_;
   u32 stageWidth_;
   u32 tmpStage_;
 
@@ -23,17 +23,18 @@ namespace Butterfly {
 RoutingAlgorithm::RoutingAlgorithm(
     const std::string& _name, const Component* _parent, Router* _router,
     u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc, u32 _numPorts,
-    u32 _numStages, u32 _stage, Json::Value _settings)
+    u32 _numStages, u32 _numPasses, u32 _stage, Json::Value _settings)
     : ::RoutingAlgorithm(_name, _parent, _router, _baseVc, _numVcs, _inputPort,
                          _inputVc, _settings),
-      numPorts_(_numPorts), numStages_(_numStages), stage_(_stage) {}
+      numPorts_(_numPorts), numStages_(_numStages), numPasses_(_numPasses),
+      stage_(_stage) {}
 
 RoutingAlgorithm::~RoutingAlgorithm() {}
 
 RoutingAlgorithm* RoutingAlgorithm::create(
     const std::string& _name, const Component* _parent, Router* _router,
     u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc, u32 _numPorts,
-    u32 _numStages, u32 _stage, Json::Value _settings) {
+    u32 _numStages, u32 _numPasses, u32 _stage, Json::Value _settings) {
   // retrieve the algorithm
   const std::string& algorithm = _settings["algorithm"].asString();
 
@@ -41,7 +42,7 @@ RoutingAlgorithm* RoutingAlgorithm::create(
   RoutingAlgorithm* ra = factory::ObjectFactory<
     RoutingAlgorithm, BUTTERFLY_ROUTINGALGORITHM_ARGS>::create(
         algorithm, _name, _parent, _router, _baseVc, _numVcs, _inputPort,
-        _inputVc, _numPorts, _numStages, _stage, _settings);
+        _inputVc, _numPorts, _numStages, _numPasses, _stage, _settings);
 
   // check that the factory had this type
   if (ra == nullptr) {
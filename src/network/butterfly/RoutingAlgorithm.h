@@ -26,7 +26,7 @@
 #include "router/Router.h"
 
 #define BUTTERFLY_ROUTINGALGORITHM_ARGS const std::string&, const Component*, \
-    Router*, u32, u32, u32, u32, u32, u32, u32, Json::Value
+    Router*, u32, u32, u32, u32, u32, u32, u32, u32, Json::Value
 
 namespace Butterfly {
 
@@ -35,7 +35,8 @@ class RoutingAlgorithm : public ::RoutingAlgorithm {
   RoutingAlgorithm(
       const std::string& _name, const Component* _parent,
       Router* _router, u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
-      u32 _numPorts, u32 _numStages, u32 _stage, Json::Value _settings);
+      u32 _numPorts, u32 _numStages, u32 _numPasses, u32 _stage,
+      Json::Value _settings);
   virtual ~RoutingAlgorithm();
 
   // this is a routing algorithm factory for the butterfly topology
@@ -44,6 +45,7 @@ class RoutingAlgorithm : public ::RoutingAlgorithm {
  protected:
   const u32 numPorts_;
   const u32 numStages_;
+  const u32 numPasses_;
   const u32 stage_;
 };
 
@@ -0,0 +1,52 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_BUTTERFLY_VALIANTSROUTINGALGORITHM_H_
+#define NETWORK_BUTTERFLY_VALIANTSROUTINGALGORITHM_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+#include "event/Component.h"
+#include "network/butterfly/RoutingAlgorithm.h"
+#include "router/Router.h"
+
+namespace Butterfly {
+
+/*
+ * This algorithm requires a butterfly with at least two passes. All passes but
+ *  the last route to a randomly chosen output port at each stage, which
+ *  delivers the packet to a random intermediate column. The last pass then
+ *  uses the destination tag. This spreads permutations like bit reverse
+ *  across the network like uniform random traffic.
+ */
+class ValiantsRoutingAlgorithm : public RoutingAlgorithm {
+ public:
+  ValiantsRoutingAlgorithm(
+      const std::string& _name, const Component* _parent, Router* _router,
+      u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc, u32 _numPorts,
+      u32 _numStages, u32 _numPasses, u32 _stage, Json::Value _settings);
+  ~ValiantsRoutingAlgorithm();
+
+ protected:
+  void processRequest(
+      Flit* _flit, RoutingAlgorithm::Response* _response) override;
+};
+
+}  // namespace Butterfly
+
+#endif  // NETWORK_BUTTERFLY_VALIANTSROUTINGALGORITHM_H_
@@ -58,6 +58,10 @@ MinimalRoutingAlgorithm::~MinimalRoutingAlgorithm() {
   delete reduction_;
 }
 
+bool MinimalRoutingAlgorithm::supportsLookahead() const {
+  return true;
+}
+
 void MinimalRoutingAlgorithm::processRequest(
     Flit* _flit, RoutingAlgorithm::Response* _response) {
   // addresses
@@ -40,6 +40,8 @@ class MinimalRoutingAlgorithm : public RoutingAlgorithm {
       Json::Value _settings);
   ~MinimalRoutingAlgorithm();
 
+  bool supportsLookahead() const override;
+
  protected:
   void processRequest(
       Flit* _flit, RoutingAlgorithm::Response* _response) override;
@@ -0,0 +1,212 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/dragonflyplus/AdaptiveRoutingAlgorithm.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <cassert>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "network/dragonfly/util.h"
+#include "types/Message.h"
+#include "types/Packet.h"
+
+namespace DragonflyPlus {
+// consts for map
+static const u32 kSrcUp = 0;
+static const u32 kSrcGlobal = 1;
+static const u32 kInterDown = 2;
+static const u32 kInterUp = 3;
+static const u32 kInterGlobal = 4;
+static const u32 kDstDown = 5;
+
+AdaptiveRoutingAlgorithm::AdaptiveRoutingAlgorithm(
+    const std::string& _name, const Component* _parent, Router* _router,
+    u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
+    u32 _leafRouters, u32 _spineRouters,
+    u32 _globalWidth, u32 _globalWeight,
+    u32 _concentration, u32 _globalPortsPerSpine,
+    Json::Value _settings)
+    : RoutingAlgorithm(_name, _parent, _router, _baseVc, _numVcs, _inputPort,
+                       _inputVc, _leafRouters, _spineRouters,
+                       _globalWidth, _globalWeight,
+                       _concentration, _globalPortsPerSpine, _settings),
+      mode_(parseRoutingMode(_settings["mode"].asString())) {
+  // Src up/global, Inter down/up, Inter global/Dst down
+  routingClasses_ = std::vector<u32>({0, 0, 1, 1, 2, 2});
+  rcs_ = 3;
+  assert(_numVcs >= rcs_);
+
+  // create the reduction
+  reduction_ = Reduction::create("Reduction", this, _router, mode_, true,
+                                 _settings["reduction"]);
+}
+
+AdaptiveRoutingAlgorithm::~AdaptiveRoutingAlgorithm() {
+  delete reduction_;
+}
+
+void AdaptiveRoutingAlgorithm::processRequest(
+    Flit* _flit, RoutingAlgorithm::Response* _response) {
+  // ex: [c,l,g]
+  const std::vector<u32>* sourceAddress =
+      _flit->packet()->message()->getSourceAddress();
+  const std::vector<u32>* destinationAddress =
+      _flit->packet()->message()->getDestinationAddress();
+  u32 sourceGroup = sourceAddress->at(2);
+  u32 destinationTerminal = destinationAddress->at(0);
+  u32 destinationLeaf = destinationAddress->at(1);
+  u32 destinationGroup = destinationAddress->at(2);
+
+  // ex: [r,g], leaves then spines
+  u32 thisRouter = router_->address().at(0);
+  u32 thisGroup = router_->address().at(1);
+  u32 globalOffset = Dragonfly::computeOffset(thisGroup, destinationGroup,
+                                              globalWidth_);
+
+  if (thisRouter < leafRouters_) {
+    // at a leaf
+    if (thisGroup == destinationGroup && thisRouter == destinationLeaf) {
+      // exit - to terminal
+      addPort(destinationTerminal, 1, U32_MAX);
+    } else if (inputPort_ >= concentration_) {
+      // bounce at intermediate group - up to the spines with a global link
+      //  to the destination group
+      assert(thisGroup != sourceGroup && thisGroup != destinationGroup);
+      for (u32 spine = 0; spine < spineRouters_; spine++) {
+        if (spineReaches(spine, globalOffset)) {
+          addPort(concentration_ + spine, 4, routingClasses_.at(kInterUp));
+        }
+      }
+    } else if (thisGroup == destinationGroup) {
+      // up - any spine reaches the destination leaf
+      for (u32 spine = 0; spine < spineRouters_; spine++) {
+        addPort(concentration_ + spine, 3, routingClasses_.at(kSrcUp));
+      }
+    } else {
+      // up - minimal to the spines with a global link to the destination
+      //  group, non-minimal to the spines with a link to any other group
+      for (u32 spine = 0; spine < spineRouters_; spine++) {
+        u32 port = concentration_ + spine;
+        for (u32 offset : spineOffsets_.at(spine)) {
+          if (offset == globalOffset) {
+            addPort(port, 4, routingClasses_.at(kSrcUp));
+            break;
+          }
+        }
+        for (u32 offset : spineOffsets_.at(spine)) {
+          if (offset > 0 && offset != globalOffset) {
+            addPort(port, 7, routingClasses_.at(kSrcUp));
+            break;
+          }
+        }
+      }
+    }
+  } else {
+    // at a spine
+    const std::vector<u32>& offsets =
+        spineOffsets_.at(thisRouter - leafRouters_);
+    if (thisGroup == destinationGroup) {
+      // down - to the destination leaf
+      addPort(destinationLeaf, 2, routingClasses_.at(kDstDown));
+    } else if (thisGroup == sourceGroup) {
+      // global - minimal to the destination group, non-minimal to any other
+      assert(inputPort_ < leafRouters_);
+      for (u32 idx = 0; idx < offsets.size(); idx++) {
+        if (offsets.at(idx) == globalOffset) {
+          addPort(leafRouters_ + idx, 3, routingClasses_.at(kSrcGlobal));
+        } else if (offsets.at(idx) > 0) {
+          addPort(leafRouters_ + idx, 6, routingClasses_.at(kSrcGlobal));
+        }
+      }
+    } else if (inputPort_ < leafRouters_) {
+      // global - after the bounce at the intermediate group
+      for (u32 idx = 0; idx < offsets.size(); idx++) {
+        if (offsets.at(idx) == globalOffset) {
+          addPort(leafRouters_ + idx, 3, routingClasses_.at(kInterGlobal));
+        }
+      }
+    } else {
+      // arrived at the intermediate group - a direct global link to the
+      //  destination group or a bounce through any leaf
+      for (u32 idx = 0; idx < offsets.size(); idx++) {
+        if (offsets.at(idx) == globalOffset) {
+          addPort(leafRouters_ + idx, 3, routingClasses_.at(kInterGlobal));
+        }
+      }
+      for (u32 leaf = 0; leaf < leafRouters_; leaf++) {
+        addPort(leaf, 5, routingClasses_.at(kInterDown));
+      }
+    }
+  }
+
+  // reduction phase
+  const std::unordered_set<std::tuple<u32, u32> >* outputs =
+      reduction_->reduce(nullptr);
+  for (const auto& t : *outputs) {
+    u32 port = std::get<0>(t);
+    if (routingModeIsPort(mode_)) {
+      // port mode
+      // add all VCs in the specified routing class
+      u32 rc = std::get<1>(t);
+      if (rc != U32_MAX) {
+        for (u32 vc = baseVc_ + rc; vc < baseVc_ + numVcs_; vc += rcs_) {
+          _response->add(port, vc);
+        }
+      } else {
+        // exit - came in with rc = U32_MAX
+        for (u32 vc = baseVc_; vc < baseVc_ + numVcs_; vc++) {
+          _response->add(port, vc);
+        }
+      }
+    } else {
+      // vc mode
+      u32 vc = std::get<1>(t);
+      _response->add(port, vc);
+    }
+  }
+}
+
+void AdaptiveRoutingAlgorithm::addPort(
+    u32 _port, u32 _hops, u32 _routingClass) {
+  // add port for reduction function
+  if (routingModeIsPort(mode_)) {
+    f64 cong = portCongestion(mode_, router_, inputPort_, inputVc_, _port);
+    reduction_->add(_port, _routingClass, _hops, cong);
+  } else {
+    if (_routingClass == U32_MAX) {
+      // add all VCs in the port
+      for (u32 vc = baseVc_; vc < baseVc_ + numVcs_; vc++) {
+        f64 cong = router_->congestionStatus(inputPort_, inputVc_, _port, vc);
+        reduction_->add(_port, vc, _hops, cong);
+      }
+    } else {
+      // add all VCs in the specified routing class
+      for (u32 vc = baseVc_ + _routingClass; vc < baseVc_ + numVcs_;
+           vc += rcs_) {
+        f64 cong = router_->congestionStatus(inputPort_, inputVc_, _port, vc);
+        reduction_->add(_port, vc, _hops, cong);
+      }
+    }
+  }
+}
+
+}  // namespace DragonflyPlus
+
+registerWithObjectFactory("adaptive", DragonflyPlus::RoutingAlgorithm,
+                          DragonflyPlus::AdaptiveRoutingAlgorithm,
+                          DRAGONFLYPLUS_ROUTINGALGORITHM_ARGS);
@@ -0,0 +1,67 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_DRAGONFLYPLUS_ADAPTIVEROUTINGALGORITHM_H_
+#define NETWORK_DRAGONFLYPLUS_ADAPTIVEROUTINGALGORITHM_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+#include "event/Component.h"
+#include "network/dragonflyplus/RoutingAlgorithm.h"
+#include "router/Router.h"
+#include "routing/mode.h"
+#include "routing/Reduction.h"
+
+namespace DragonflyPlus {
+
+/*
+ * This chooses between minimal and non-minimal global routes at the source
+ *  leaf and again at the source spine. A non-minimal route crosses a global
+ *  link to an intermediate group where it either continues on a direct global
+ *  link or bounces through a leaf to a spine that has one. As with the
+ *  dragonfly adaptive routing, each hop uses the VCs of a routing class:
+ *  source up and global hops, intermediate group down and up hops, and the
+ *  final global and down hops.
+ */
+class AdaptiveRoutingAlgorithm : public RoutingAlgorithm {
+ public:
+  AdaptiveRoutingAlgorithm(
+      const std::string& _name, const Component* _parent, Router* _router,
+      u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
+      u32 _leafRouters, u32 _spineRouters,
+      u32 _globalWidth, u32 _globalWeight,
+      u32 _concentration, u32 _globalPortsPerSpine,
+      Json::Value _settings);
+  ~AdaptiveRoutingAlgorithm();
+
+ protected:
+  void processRequest(
+      Flit* _flit, RoutingAlgorithm::Response* _response) override;
+
+ private:
+  void addPort(u32 _port, u32 _hops, u32 _routingClass);
+
+  u32 rcs_;
+  std::vector<u32> routingClasses_;
+  const RoutingMode mode_;
+  Reduction* reduction_;
+};
+
+}  // namespace DragonflyPlus
+
+#endif  // NETWORK_DRAGONFLYPLUS_ADAPTIVEROUTINGALGORITHM_H_
@@ -0,0 +1,140 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/dragonflyplus/MinimalRoutingAlgorithm.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <cassert>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "network/dragonfly/util.h"
+#include "types/Message.h"
+#include "types/Packet.h"
+
+namespace DragonflyPlus {
+
+MinimalRoutingAlgorithm::MinimalRoutingAlgorithm(
+    const std::string& _name, const Component* _parent, Router* _router,
+    u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
+    u32 _leafRouters, u32 _spineRouters,
+    u32 _globalWidth, u32 _globalWeight,
+    u32 _concentration, u32 _globalPortsPerSpine,
+    Json::Value _settings)
+    : RoutingAlgorithm(_name, _parent, _router, _baseVc, _numVcs, _inputPort,
+                       _inputVc, _leafRouters, _spineRouters,
+                       _globalWidth, _globalWeight,
+                       _concentration, _globalPortsPerSpine, _settings),
+      mode_(parseRoutingMode(_settings["mode"].asString())) {
+  // create the reduction
+  reduction_ = Reduction::create("Reduction", this, _router, mode_, true,
+                                 _settings["reduction"]);
+}
+
+MinimalRoutingAlgorithm::~MinimalRoutingAlgorithm() {
+  delete reduction_;
+}
+
+void MinimalRoutingAlgorithm::processRequest(
+    Flit* _flit, RoutingAlgorithm::Response* _response) {
+  // ex: [c,l,g]
+  const std::vector<u32>* destinationAddress =
+      _flit->packet()->message()->getDestinationAddress();
+  u32 destinationTerminal = destinationAddress->at(0);
+  u32 destinationLeaf = destinationAddress->at(1);
+  u32 destinationGroup = destinationAddress->at(2);
+
+  // ex: [r,g], leaves then spines
+  u32 thisRouter = router_->address().at(0);
+  u32 thisGroup = router_->address().at(1);
+  u32 globalOffset = Dragonfly::computeOffset(thisGroup, destinationGroup,
+                                              globalWidth_);
+
+  if (thisRouter < leafRouters_) {
+    // at a leaf
+    if (thisGroup == destinationGroup && thisRouter == destinationLeaf) {
+      // exit - to terminal
+      addPort(destinationTerminal, 1);
+    } else if (thisGroup == destinationGroup) {
+      // up - any spine reaches the destination leaf
+      assert(inputPort_ < concentration_);
+      for (u32 spine = 0; spine < spineRouters_; spine++) {
+        addPort(concentration_ + spine, 3);
+      }
+    } else {
+      // up - to the spines with a global link to the destination group
+      assert(inputPort_ < concentration_);
+      for (u32 spine = 0; spine < spineRouters_; spine++) {
+        if (spineReaches(spine, globalOffset)) {
+          addPort(concentration_ + spine, 4);
+        }
+      }
+    }
+  } else {
+    // at a spine
+    u32 spine = thisRouter - leafRouters_;
+    if (thisGroup == destinationGroup) {
+      // down - to the destination leaf
+      addPort(destinationLeaf, 2);
+    } else {
+      // global - to the destination group
+      assert(inputPort_ < leafRouters_);
+      const std::vector<u32>& offsets = spineOffsets_.at(spine);
+      for (u32 idx = 0; idx < offsets.size(); idx++) {
+        if (offsets.at(idx) == globalOffset) {
+          addPort(leafRouters_ + idx, 3);
+        }
+      }
+    }
+  }
+
+  // reduction phase
+  const std::unordered_set<std::tuple<u32, u32> >* outputs =
+      reduction_->reduce(nullptr);
+  for (const auto& t : *outputs) {
+    u32 port = std::get<0>(t);
+    if (routingModeIsPort(mode_)) {
+      // port mode - all VCs
+      for (u32 vc = baseVc_; vc < baseVc_ + numVcs_; vc++) {
+        _response->add(port, vc);
+      }
+    } else {
+      // vc mode
+      u32 vc = std::get<1>(t);
+      _response->add(port, vc);
+    }
+  }
+}
+
+void MinimalRoutingAlgorithm::addPort(u32 _port, u32 _hops) {
+  if (routingModeIsPort(mode_)) {
+    // port mode
+    f64 cong = portCongestion(mode_, router_, inputPort_, inputVc_, _port);
+    reduction_->add(_port, 0, _hops, cong);
+  } else {
+    // vc mode - add all VCs in the port
+    for (u32 vc = baseVc_; vc < baseVc_ + numVcs_; vc++) {
+      f64 cong = router_->congestionStatus(inputPort_, inputVc_, _port, vc);
+      reduction_->add(_port, vc, _hops, cong);
+    }
+  }
+}
+
+}  // namespace DragonflyPlus
+
+registerWithObjectFactory("minimal", DragonflyPlus::RoutingAlgorithm,
+                          DragonflyPlus::MinimalRoutingAlgorithm,
+                          DRAGONFLYPLUS_ROUTINGALGORITHM_ARGS);
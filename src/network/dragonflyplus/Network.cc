@@ -0,0 +1,277 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/dragonflyplus/Network.h"
+
+#include <factory/ObjectFactory.h>
+#include <strop/strop.h>
+
+#include <cassert>
+
+#include "network/dragonfly/util.h"
+#include "network/dragonflyplus/RoutingAlgorithm.h"
+#include "network/dragonflyplus/util.h"
+
+namespace DragonflyPlus {
+
+Network::Network(const std::string& _name, const Component* _parent,
+                 MetadataHandler* _metadataHandler, Json::Value _settings)
+    : ::Network(_name, _parent, _metadataHandler, _settings) {
+  // concentration
+  assert(_settings.isMember("concentration"));
+  concentration_ = _settings["concentration"].asUInt();
+  assert(concentration_ > 0);
+
+  // groups
+  assert(_settings.isMember("leaf_routers"));
+  leafRouters_ = _settings["leaf_routers"].asUInt();
+  assert(_settings.isMember("spine_routers"));
+  spineRouters_ = _settings["spine_routers"].asUInt();
+  assert(leafRouters_ > 0);
+  assert(spineRouters_ > 0);
+
+  // global
+  assert(_settings.isMember("global_width"));
+  globalWidth_ = _settings["global_width"].asUInt();
+  assert(_settings.isMember("global_weight"));
+  globalWeight_ = _settings["global_weight"].asUInt();
+  assert(globalWidth_ > 0);
+  assert(globalWeight_ > 0);
+
+  // channels
+  assert(_settings.isMember("global_channel"));
+  assert(_settings.isMember("local_channel"));
+  assert(_settings.isMember("external_channel"));
+
+  // radix
+  globalPortsPerSpine_ = computeGlobalPortsPerSpine(
+      globalWidth_, globalWeight_, spineRouters_);
+  u32 leafRadix = concentration_ + spineRouters_;
+  u32 spineRadix = leafRouters_ + globalPortsPerSpine_;
+
+  // parse the protocol classes description
+  loadProtocolClassInfo(_settings["protocol_classes"]);
+
+  // create routers
+  u32 groupRouters = leafRouters_ + spineRouters_;
+  routers_.resize(globalWidth_ * groupRouters, nullptr);
+  for (u32 id = 0; id < routers_.size(); id++) {
+    std::vector<u32> routerAddress;
+    translateRouterIdToAddress(id, &routerAddress);
+    u32 routerRadix =
+        (routerAddress.at(0) < leafRouters_) ? leafRadix : spineRadix;
+    std::string routerName =
+        "Router_" + strop::vecString<u32>(routerAddress, '-');
+    routers_.at(id) = Router::create(
+        routerName, this, this, id, routerAddress, routerRadix, numVcs_,
+        protocolClassVcs_, _metadataHandler, _settings["router"]);
+  }
+
+  // create global channels, link the spines of the groups
+  for (u32 srcGroup = 0; srcGroup < globalWidth_; srcGroup++) {
+    for (u32 fwdOffset = 1; fwdOffset < globalWidth_; fwdOffset++) {
+      u32 dstGroup = (srcGroup + fwdOffset) % globalWidth_;
+      u32 reverseOffset = globalWidth_ - fwdOffset;
+      for (u32 weight = 0; weight < globalWeight_; weight++) {
+        u32 srcSpine, srcPort;
+        computeGlobalLink(leafRouters_, globalPortsPerSpine_, globalWidth_,
+                          globalWeight_, spineRouters_, weight, fwdOffset,
+                          &srcSpine, &srcPort);
+        u32 dstSpine, dstPort;
+        computeGlobalLink(leafRouters_, globalPortsPerSpine_, globalWidth_,
+                          globalWeight_, spineRouters_, weight, reverseOffset,
+                          &dstSpine, &dstPort);
+        Router* srcRouter = routers_.at(
+            (srcGroup * groupRouters) + leafRouters_ + srcSpine);
+        Router* dstRouter = routers_.at(
+            (dstGroup * groupRouters) + leafRouters_ + dstSpine);
+
+        std::string channelName =
+            "GlobalChannel_" +
+            strop::vecString<u32>(srcRouter->address(), '-') + "-to-" +
+            strop::vecString<u32>(dstRouter->address(), '-') + "-" +
+            std::to_string(weight);
+        Channel* channel = new Channel(channelName, this, numVcs_,
+                                       _settings["global_channel"]);
+        globalChannels_.push_back(channel);
+
+        srcRouter->setOutputChannel(srcPort, channel);
+        dstRouter->setInputChannel(dstPort, channel);
+      }
+    }
+  }
+
+  // create local channels, link every leaf with every spine in both ways
+  for (u32 group = 0; group < globalWidth_; group++) {
+    for (u32 leaf = 0; leaf < leafRouters_; leaf++) {
+      Router* leafRouter = routers_.at((group * groupRouters) + leaf);
+      for (u32 spine = 0; spine < spineRouters_; spine++) {
+        Router* spineRouter = routers_.at(
+            (group * groupRouters) + leafRouters_ + spine);
+        for (u32 dir = 0; dir < 2; dir++) {
+          Router* src = (dir == 0) ? leafRouter : spineRouter;
+          Router* dst = (dir == 0) ? spineRouter : leafRouter;
+          std::string channelName =
+              "LocalChannel_" + strop::vecString<u32>(src->address(), '-') +
+              "-to-" + strop::vecString<u32>(dst->address(), '-');
+          Channel* channel = new Channel(channelName, this, numVcs_,
+                                         _settings["local_channel"]);
+          localChannels_.push_back(channel);
+
+          if (dir == 0) {
+            leafRouter->setOutputChannel(concentration_ + spine, channel);
+            spineRouter->setInputChannel(leaf, channel);
+          } else {
+            spineRouter->setOutputChannel(leaf, channel);
+            leafRouter->setInputChannel(concentration_ + spine, channel);
+          }
+        }
+      }
+    }
+  }
+
+  // create interfaces and link them with the leaf routers
+  interfaces_.resize(globalWidth_ * leafRouters_ * concentration_, nullptr);
+  for (u32 id = 0; id < interfaces_.size(); id++) {
+    std::vector<u32> interfaceAddress;
+    translateInterfaceIdToAddress(id, &interfaceAddress);
+    u32 conc = interfaceAddress.at(0);
+    Router* router = routers_.at(
+        (interfaceAddress.at(2) * groupRouters) + interfaceAddress.at(1));
+
+    std::string interfaceName =
+        "Interface_" + strop::vecString<u32>(interfaceAddress, '-');
+    Interface* interface = Interface::create(
+        interfaceName, this, id, interfaceAddress, numVcs_,
+        protocolClassVcs_, _metadataHandler, _settings["interface"]);
+    interfaces_.at(id) = interface;
+
+    // create I/O channels
+    std::string inChannelName =
+        "Channel_" + strop::vecString<u32>(interfaceAddress, '-') + "-to-" +
+        strop::vecString<u32>(router->address(), '-');
+    std::string outChannelName =
+        "Channel_" + strop::vecString<u32>(router->address(), '-') + "-to-" +
+        strop::vecString<u32>(interfaceAddress, '-');
+    Channel* inChannel = new Channel(inChannelName, this, numVcs_,
+                                     _settings["external_channel"]);
+    Channel* outChannel = new Channel(outChannelName, this, numVcs_,
+                                      _settings["external_channel"]);
+    externalChannels_.push_back(inChannel);
+    externalChannels_.push_back(outChannel);
+
+    // link with router
+    router->setInputChannel(conc, inChannel);
+    interface->setOutputChannel(0, inChannel);
+    router->setOutputChannel(conc, outChannel);
+    interface->setInputChannel(0, outChannel);
+  }
+
+  // clear the protocol class info
+  clearProtocolClassInfo();
+}
+
+Network::~Network() {
+  for (Router* router : routers_) {
+    delete router;
+  }
+  for (Interface* interface : interfaces_) {
+    delete interface;
+  }
+  for (Channel* channel : globalChannels_) {
+    delete channel;
+  }
+  for (Channel* channel : localChannels_) {
+    delete channel;
+  }
+  for (Channel* channel : externalChannels_) {
+    delete channel;
+  }
+}
+
+::RoutingAlgorithm* Network::createRoutingAlgorithm(
+     u32 _inputPort, u32 _inputVc, const std::string& _name,
+     const Component* _parent, Router* _router) {
+  // get the info
+  const Network::RoutingAlgorithmInfo& info =
+      routingAlgorithmInfo_.at(_inputVc);
+
+  // call the routing algorithm factory
+  return RoutingAlgorithm::create(
+      _name, _parent, _router, info.baseVc, info.numVcs, _inputPort, _inputVc,
+      leafRouters_, spineRouters_, globalWidth_, globalWeight_, concentration_,
+      globalPortsPerSpine_, info.settings);
+}
+
+u32 Network::numRouters() const {
+  return routers_.size();
+}
+
+u32 Network::numInterfaces() const {
+  return interfaces_.size();
+}
+
+Router* Network::getRouter(u32 _id) const {
+  return routers_.at(_id);
+}
+
+Interface* Network::getInterface(u32 _id) const {
+  return interfaces_.at(_id);
+}
+
+void Network::translateInterfaceIdToAddress(
+    u32 _id, std::vector<u32>* _address) const {
+  Dragonfly::translateInterfaceIdToAddress(
+      concentration_, leafRouters_, _id, _address);
+}
+
+u32 Network::translateInterfaceAddressToId(
+    const std::vector<u32>* _address) const {
+  return Dragonfly::translateInterfaceAddressToId(
+      concentration_, leafRouters_, _address);
+}
+
+void Network::translateRouterIdToAddress(
+    u32 _id, std::vector<u32>* _address) const {
+  Dragonfly::translateRouterIdToAddress(
+      leafRouters_ + spineRouters_, _id, _address);
+}
+
+u32 Network::translateRouterAddressToId(
+    const std::vector<u32>* _address) const {
+  return Dragonfly::translateRouterAddressToId(
+      leafRouters_ + spineRouters_, _address);
+}
+
+u32 Network::computeMinimalHops(const std::vector<u32>* _source,
+                                const std::vector<u32>* _destination) const {
+  return DragonflyPlus::computeMinimalHops(_source, _destination);
+}
+
+void Network::collectChannels(std::vector<Channel*>* _channels) {
+  for (Channel* channel : externalChannels_) {
+    _channels->push_back(channel);
+  }
+  for (Channel* channel : localChannels_) {
+    _channels->push_back(channel);
+  }
+  for (Channel* channel : globalChannels_) {
+    _channels->push_back(channel);
+  }
+}
+
+}  // namespace DragonflyPlus
+
+registerWithObjectFactory("dragonflyplus", ::Network,
+                          DragonflyPlus::Network, NETWORK_ARGS);
@@ -0,0 +1,88 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_DRAGONFLYPLUS_NETWORK_H_
+#define NETWORK_DRAGONFLYPLUS_NETWORK_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+#include "event/Component.h"
+#include "interface/Interface.h"
+#include "network/Channel.h"
+#include "network/Network.h"
+#include "router/Router.h"
+
+namespace DragonflyPlus {
+
+/*
+ * This is a Dragonfly+ (Megafly) where each group is a two-level fat-tree
+ *  with every leaf router linked to every spine router. Leaf ports
+ *  [0,concentration) connect the interfaces followed by one port per spine.
+ *  Spine ports [0,leaf_routers) connect the leaves followed by the global
+ *  ports, which are assigned to the spines as the dragonfly assigns them to
+ *  its group routers. Routers are addressed as [r,g] with the leaves before
+ *  the spines and interfaces as [c,l,g].
+ */
+class Network : public ::Network {
+ public:
+  Network(const std::string& _name, const Component* _parent,
+          MetadataHandler* _metadataHandler, Json::Value _settings);
+  ~Network();
+
+  // this is the routing algorithm factory for this network
+  ::RoutingAlgorithm* createRoutingAlgorithm(
+       u32 _inputPort, u32 _inputVc, const std::string& _name,
+       const Component* _parent, Router* _router) override;
+
+  // Network
+  u32 numRouters() const override;
+  u32 numInterfaces() const override;
+  Router* getRouter(u32 _id) const override;
+  Interface* getInterface(u32 _id) const override;
+  void translateInterfaceIdToAddress(
+      u32 _id, std::vector<u32>* _address) const override;
+  u32 translateInterfaceAddressToId(
+      const std::vector<u32>* _address) const override;
+  void translateRouterIdToAddress(
+      u32 _id, std::vector<u32>* _address) const override;
+  u32 translateRouterAddressToId(
+      const std::vector<u32>* _address) const override;
+  u32 computeMinimalHops(const std::vector<u32>* _source,
+                         const std::vector<u32>* _destination) const override;
+
+ protected:
+  void collectChannels(std::vector<Channel*>* _channels) override;
+
+ private:
+  u32 leafRouters_;
+  u32 spineRouters_;
+  u32 concentration_;
+  u32 globalWidth_;
+  u32 globalWeight_;
+  u32 globalPortsPerSpine_;
+
+  std::vector<Router*> routers_;
+  std::vector<Interface*> interfaces_;
+  std::vector<Channel*> globalChannels_;
+  std::vector<Channel*> localChannels_;
+  std::vector<Channel*> externalChannels_;
+};
+
+}  // namespace DragonflyPlus
+
+#endif  // NETWORK_DRAGONFLYPLUS_NETWORK_H_
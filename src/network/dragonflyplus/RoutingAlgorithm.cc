@@ -0,0 +1,83 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/dragonflyplus/RoutingAlgorithm.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <cassert>
+
+#include "network/dragonflyplus/util.h"
+
+namespace DragonflyPlus {
+
+RoutingAlgorithm::RoutingAlgorithm(
+    const std::string& _name, const Component* _parent, Router* _router,
+    u32 _baseVc, u32 _numVcs,
+    u32 _inputPort, u32 _inputVc,
+    u32 _leafRouters, u32 _spineRouters,
+    u32 _globalWidth, u32 _globalWeight,
+    u32 _concentration, u32 _globalPortsPerSpine,
+    Json::Value _settings)
+    : ::RoutingAlgorithm(_name, _parent, _router, _baseVc, _numVcs, _inputPort,
+                         _inputVc, _settings),
+      leafRouters_(_leafRouters), spineRouters_(_spineRouters),
+      globalWidth_(_globalWidth), globalWeight_(_globalWeight),
+      concentration_(_concentration),
+      globalPortsPerSpine_(_globalPortsPerSpine) {
+  spineOffsets_.resize(spineRouters_);
+  for (u32 spine = 0; spine < spineRouters_; spine++) {
+    computeSpineOffsets(globalPortsPerSpine_, globalWidth_, globalWeight_,
+                        spine, &spineOffsets_.at(spine));
+  }
+}
+
+RoutingAlgorithm::~RoutingAlgorithm() {}
+
+RoutingAlgorithm* RoutingAlgorithm::create(
+    const std::string& _name, const Component* _parent, Router* _router,
+    u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
+    u32 _leafRouters, u32 _spineRouters,
+    u32 _globalWidth, u32 _globalWeight,
+    u32 _concentration, u32 _globalPortsPerSpine,
+    Json::Value _settings) {
+  // retrieve the algorithm
+  const std::string& algorithm = _settings["algorithm"].asString();
+
+  // attempt to create the routing algorithm
+  RoutingAlgorithm* ra = factory::ObjectFactory<
+    RoutingAlgorithm, DRAGONFLYPLUS_ROUTINGALGORITHM_ARGS>::create(
+        algorithm, _name, _parent, _router, _baseVc, _numVcs, _inputPort,
+        _inputVc, _leafRouters, _spineRouters, _globalWidth, _globalWeight,
+        _concentration, _globalPortsPerSpine, _settings);
+
+  // check that the factory had this type
+  if (ra == nullptr) {
+    fprintf(stderr, "invalid Dragonfly+ routing algorithm: %s\n",
+            algorithm.c_str());
+    assert(false);
+  }
+  return ra;
+}
+
+bool RoutingAlgorithm::spineReaches(u32 _spine, u32 _offset) const {
+  for (u32 offset : spineOffsets_.at(_spine)) {
+    if (offset == _offset) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace DragonflyPlus
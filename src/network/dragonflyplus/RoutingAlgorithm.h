@@ -0,0 +1,68 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_DRAGONFLYPLUS_ROUTINGALGORITHM_H_
+#define NETWORK_DRAGONFLYPLUS_ROUTINGALGORITHM_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+#include "event/Component.h"
+#include "routing/RoutingAlgorithm.h"
+#include "router/Router.h"
+
+#define DRAGONFLYPLUS_ROUTINGALGORITHM_ARGS const std::string&, \
+    const Component*, Router*, u32, u32, u32, u32, u32, u32, u32, u32, u32, \
+    u32, Json::Value
+
+namespace DragonflyPlus {
+
+class RoutingAlgorithm : public ::RoutingAlgorithm {
+ public:
+  RoutingAlgorithm(
+      const std::string& _name, const Component* _parent, Router* _router,
+      u32 _baseVc, u32 _numVcs,
+      u32 _inputPort, u32 _inputVc,
+      u32 _leafRouters, u32 _spineRouters,
+      u32 _globalWidth, u32 _globalWeight,
+      u32 _concentration, u32 _globalPortsPerSpine,
+      Json::Value _settings);
+  virtual ~RoutingAlgorithm();
+
+  // this is a routing algorithm factory for the dragonfly+ topology
+  static RoutingAlgorithm* create(DRAGONFLYPLUS_ROUTINGALGORITHM_ARGS);
+
+ protected:
+  // true if the spine router has a global link with the group offset
+  bool spineReaches(u32 _spine, u32 _offset) const;
+
+  const u32 leafRouters_;
+  const u32 spineRouters_;
+
+  const u32 globalWidth_;
+  const u32 globalWeight_;
+
+  const u32 concentration_;
+  const u32 globalPortsPerSpine_;
+
+  // group offset of each global port of each spine router (0 is unused)
+  std::vector<std::vector<u32> > spineOffsets_;
+};
+
+}  // namespace DragonflyPlus
+
+#endif  // NETWORK_DRAGONFLYPLUS_ROUTINGALGORITHM_H_
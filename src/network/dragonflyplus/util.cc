@@ -0,0 +1,72 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/dragonflyplus/util.h"
+
+#include <cassert>
+
+#include "network/dragonfly/util.h"
+
+namespace DragonflyPlus {
+
+u32 computeGlobalPortsPerSpine(u32 _globalWidth, u32 _globalWeight,
+                               u32 _spineRouters) {
+  u32 groupRadix = (_globalWidth - 1) * _globalWeight;
+  return (groupRadix + _spineRouters - 1) / _spineRouters;
+}
+
+void computeGlobalLink(u32 _leafRouters, u32 _globalPortsPerSpine,
+                       u32 _globalWidth, u32 _globalWeight,
+                       u32 _spineRouters, u32 _weight, u32 _offset,
+                       u32* _spine, u32* _port) {
+  // the spines take the place of the dragonfly group routers and their
+  //  global ports follow the ports to the leaf routers
+  assert(_offset > 0 && _offset < _globalWidth);
+  u32 globalPort;
+  Dragonfly::computeGlobalToRouterMap(_leafRouters, _globalPortsPerSpine,
+                                      _globalWidth, _globalWeight,
+                                      _spineRouters, _weight, _offset,
+                                      &globalPort, _spine, _port);
+}
+
+void computeSpineOffsets(u32 _globalPortsPerSpine, u32 _globalWidth,
+                         u32 _globalWeight, u32 _spine,
+                         std::vector<u32>* _offsets) {
+  _offsets->resize(_globalPortsPerSpine);
+  for (u32 idx = 0; idx < _globalPortsPerSpine; idx++) {
+    u32 globalPort = (_spine * _globalPortsPerSpine) + idx;
+    if (globalPort < (_globalWidth - 1) * _globalWeight) {
+      _offsets->at(idx) = (globalPort % (_globalWidth - 1)) + 1;
+    } else {
+      _offsets->at(idx) = 0;
+    }
+  }
+}
+
+u32 computeMinimalHops(const std::vector<u32>* _source,
+                       const std::vector<u32>* _destination) {
+  assert(_source->size() == 3);
+  assert(_destination->size() == 3);
+  if (_source->at(2) != _destination->at(2)) {
+    // leaf, spine, spine, leaf
+    return 4;
+  } else if (_source->at(1) != _destination->at(1)) {
+    // leaf, spine, leaf
+    return 3;
+  } else {
+    return 1;
+  }
+}
+
+}  // namespace DragonflyPlus
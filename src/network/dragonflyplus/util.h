@@ -0,0 +1,44 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_DRAGONFLYPLUS_UTIL_H_
+#define NETWORK_DRAGONFLYPLUS_UTIL_H_
+
+#include <prim/prim.h>
+
+#include <vector>
+
+namespace DragonflyPlus {
+// the number of global ports of each spine router
+u32 computeGlobalPortsPerSpine(u32 _globalWidth, u32 _globalWeight,
+                               u32 _spineRouters);
+
+// the spine router and its port that hold the group global link of the
+//  given weight and group offset
+void computeGlobalLink(u32 _leafRouters, u32 _globalPortsPerSpine,
+                       u32 _globalWidth, u32 _globalWeight,
+                       u32 _spineRouters, u32 _weight, u32 _offset,
+                       u32* _spine, u32* _port);
+
+// the group offset reached by each global port of a spine router, 0 marks an
+//  unused port
+void computeSpineOffsets(u32 _globalPortsPerSpine, u32 _globalWidth,
+                         u32 _globalWeight, u32 _spine,
+                         std::vector<u32>* _offsets);
+
+u32 computeMinimalHops(const std::vector<u32>* _source,
+                       const std::vector<u32>* _destination);
+}  // namespace DragonflyPlus
+
+#endif  // NETWORK_DRAGONFLYPLUS_UTIL_H_
@@ -0,0 +1,83 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/dragonflyplus/util.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <vector>
+
+TEST(DragonflyPlus, computeGlobalPortsPerSpine) {
+  ASSERT_EQ(2u, DragonflyPlus::computeGlobalPortsPerSpine(9, 1, 4));
+  ASSERT_EQ(3u, DragonflyPlus::computeGlobalPortsPerSpine(9, 1, 3));
+  ASSERT_EQ(4u, DragonflyPlus::computeGlobalPortsPerSpine(5, 2, 2));
+  ASSERT_EQ(3u, DragonflyPlus::computeGlobalPortsPerSpine(8, 1, 3));
+}
+
+TEST(DragonflyPlus, globalLinks) {
+  for (u32 globalWidth : {2u, 5u, 8u, 9u}) {
+    for (u32 globalWeight : {1u, 2u}) {
+      for (u32 spines : {1u, 3u, 4u}) {
+        u32 leaves = 5;
+        u32 perSpine = DragonflyPlus::computeGlobalPortsPerSpine(
+            globalWidth, globalWeight, spines);
+        std::vector<std::vector<u32> > offsets(spines);
+        for (u32 spine = 0; spine < spines; spine++) {
+          DragonflyPlus::computeSpineOffsets(perSpine, globalWidth,
+                                             globalWeight, spine,
+                                             &offsets.at(spine));
+        }
+
+        // every group link is on a distinct spine port which knows its offset
+        std::vector<std::vector<bool> > used(
+            spines, std::vector<bool>(perSpine, false));
+        for (u32 weight = 0; weight < globalWeight; weight++) {
+          for (u32 offset = 1; offset < globalWidth; offset++) {
+            u32 spine, port;
+            DragonflyPlus::computeGlobalLink(leaves, perSpine, globalWidth,
+                                             globalWeight, spines, weight,
+                                             offset, &spine, &port);
+            ASSERT_LT(spine, spines);
+            ASSERT_GE(port, leaves);
+            ASSERT_LT(port, leaves + perSpine);
+            ASSERT_FALSE(used.at(spine).at(port - leaves));
+            used.at(spine).at(port - leaves) = true;
+            ASSERT_EQ(offset, offsets.at(spine).at(port - leaves));
+          }
+        }
+
+        // the remaining ports are unused
+        for (u32 spine = 0; spine < spines; spine++) {
+          for (u32 idx = 0; idx < perSpine; idx++) {
+            ASSERT_EQ(!used.at(spine).at(idx),
+                      offsets.at(spine).at(idx) == 0);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(DragonflyPlus, computeMinimalHops) {
+  std::vector<u32> src({1, 2, 3});
+  std::vector<u32> dst;
+
+  dst = {0, 2, 3};
+  ASSERT_EQ(1u, DragonflyPlus::computeMinimalHops(&src, &dst));
+  dst = {1, 0, 3};
+  ASSERT_EQ(3u, DragonflyPlus::computeMinimalHops(&src, &dst));
+  dst = {1, 2, 0};
+  ASSERT_EQ(4u, DragonflyPlus::computeMinimalHops(&src, &dst));
+}
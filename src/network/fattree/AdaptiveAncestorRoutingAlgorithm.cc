@@ -0,0 +1,217 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/fattree/AdaptiveAncestorRoutingAlgorithm.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <cassert>
+
+#include <tuple>
+#include <vector>
+
+#include "event/Simulator.h"
+#include "network/fattree/util.h"
+#include "types/Packet.h"
+#include "types/Message.h"
+
+namespace FatTree {
+
+AdaptiveAncestorRoutingAlgorithm::AdaptiveAncestorRoutingAlgorithm(
+    const std::string& _name, const Component* _parent, Router* _router,
+    u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
+    const std::vector<std::tuple<u32, u32, u32> >* _radices,
+    FlowletTable* _flowlets, Json::Value _settings)
+    : RoutingAlgorithm(_name, _parent, _router, _baseVc, _numVcs, _inputPort,
+                       _inputVc, _radices, _flowlets, _settings),
+      mode_(parseRoutingMode(_settings["mode"].asString())),
+      leastCommonAncestor_(_settings["least_common_ancestor"].asBool()),
+      congestionThreshold_(_settings["congestion_threshold"].asDouble()),
+      flowletTimeout_(_settings["flowlet_timeout"].asUInt64()),
+      flowletTableSize_(_settings["flowlet_table_size"].asUInt()),
+      random_(gSim->rnd.nextU64(0, 0xdeadbeef)), flowlets_(nullptr) {
+  assert(_settings.isMember("mode"));
+  assert(_settings.isMember("least_common_ancestor"));
+  assert(_settings.isMember("congestion_threshold"));
+  assert(congestionThreshold_ >= 0.0);
+  assert(_settings.isMember("flowlet_timeout"));
+  assert(_settings.isMember("flowlet_table_size"));
+
+  // share the network's flowlet table of the protocol class in this router
+  if (flowletTimeout_ > 0) {
+    assert(flowletTableSize_ > 0);
+    assert(flowletTable_ != nullptr);
+    if (flowletTable_->empty()) {
+      flowletTable_->resize(flowletTableSize_,
+                            {U32_MAX, U32_MAX, U32_MAX, 0});
+    }
+    assert(flowletTable_->size() == flowletTableSize_);
+    flowlets_ = flowletTable_;
+  }
+
+  // create the reduction
+  reduction_ = Reduction::create("Reduction", this, _router, mode_,
+                                 false, _settings["reduction"]);
+}
+
+AdaptiveAncestorRoutingAlgorithm::~AdaptiveAncestorRoutingAlgorithm() {
+  delete reduction_;
+}
+
+void AdaptiveAncestorRoutingAlgorithm::processRequest(
+    Flit* _flit, RoutingAlgorithm::Response* _response) {
+  // addresses
+  const std::vector<u32>* sourceAddress =
+      _flit->packet()->message()->getSourceAddress();
+  const std::vector<u32>* destinationAddress =
+      _flit->packet()->message()->getDestinationAddress();
+  assert(sourceAddress->size() == destinationAddress->size());
+
+  // topology info
+  const u32 level = router_->address().at(0);
+  const u32 numLevels = sourceAddress->size();
+  const u32 downPorts = std::get<0>(radices_->at(level));
+  const u32 upPorts = std::get<1>(radices_->at(level));
+
+  // current location info
+  bool atTopLevel = (level == (numLevels - 1));
+  bool movingUpward = (!atTopLevel) && (inputPort_ < downPorts);
+  u32 lca = leastCommonAncestor(sourceAddress, destinationAddress);
+
+  // determine if an early turn around will occur
+  if (movingUpward && leastCommonAncestor_) {
+    // determine if this router is an ancester of the destination
+    assert(lca >= level);
+    if (lca == level) {
+      movingUpward = false;
+    }
+  }
+
+  // determine hop to destination
+  u32 hops;
+  if (movingUpward) {
+    assert(level < numLevels - 1);
+    if (leastCommonAncestor_) {
+      hops = (lca + 1) + (lca - level);
+    } else {
+      hops = numLevels + (numLevels - level - 1);
+    }
+  } else {
+    hops = level + 1;
+  }
+
+  // select the outputs
+  if (!movingUpward) {
+    // moving downward on a deterministic path
+    u32 port = destinationAddress->at(level);
+    addPort(port, hops);
+  } else {
+    // moving upward
+    u32 sourceId = _flit->packet()->message()->getSourceId();
+    u32 destinationId = _flit->packet()->message()->getDestinationId();
+    u64 now = gSim->cycle(Simulator::Clock::ROUTER);
+
+    u32 port;
+    if (flowlets_ != nullptr) {
+      // flows sharing a table entry replace each other
+      Flowlet& flowlet = flowlets_->at(
+          flowHasher_(std::make_tuple(sourceId, destinationId)) %
+          flowletTableSize_);
+      if ((flowlet.source == sourceId) &&
+          (flowlet.destination == destinationId) &&
+          (now - flowlet.time <= flowletTimeout_)) {
+        // the flowlet is still active, stay on its port
+        port = flowlet.port;
+      } else {
+        port = selectUpPort(destinationId, downPorts, upPorts);
+      }
+      flowlet = {sourceId, destinationId, port, now};
+    } else {
+      port = selectUpPort(destinationId, downPorts, upPorts);
+    }
+    addPort(port, hops);
+  }
+
+  // reduction phase
+  const std::unordered_set<std::tuple<u32, u32> >* outputs =
+      reduction_->reduce(nullptr);
+  for (const auto& t : *outputs) {
+    u32 port = std::get<0>(t);
+    u32 vc = std::get<1>(t);
+    if (vc == U32_MAX) {
+      for (u32 vc = baseVc_; vc < baseVc_ + numVcs_; vc++) {
+        _response->add(port, vc);
+      }
+    } else {
+      _response->add(port, vc);
+    }
+  }
+}
+
+u32 AdaptiveAncestorRoutingAlgorithm::selectUpPort(
+    u32 _destinationId, u32 _downPorts, u32 _upPorts) {
+  // find the least congested up ports
+  f64 minCongestion = F64_POS_INF;
+  std::vector<u32> minPorts;
+  for (u32 up = 0; up < _upPorts; up++) {
+    u32 port = _downPorts + up;
+    f64 cong = upPortCongestion(port);
+    if (cong < minCongestion) {
+      minCongestion = cong;
+      minPorts.clear();
+    }
+    if (cong == minCongestion) {
+      minPorts.push_back(port);
+    }
+  }
+
+  // fall back to the hashed port while it is close enough to the least
+  //  congested port, otherwise choose randomly among the least congested
+  u32 hashPort = _downPorts +
+      (hasher_(std::make_tuple(_destinationId, random_)) % _upPorts);
+  if (upPortCongestion(hashPort) <= minCongestion + congestionThreshold_) {
+    return hashPort;
+  } else {
+    return minPorts.at(gSim->rnd.nextU64(0, minPorts.size() - 1));
+  }
+}
+
+f64 AdaptiveAncestorRoutingAlgorithm::upPortCongestion(u32 _port) const {
+  if (routingModeIsPort(mode_)) {
+    return portCongestion(mode_, router_, inputPort_, inputVc_, _port);
+  } else {
+    // in VC mode the port is judged by the average of its VCs
+    return averagePortCongestion(router_, inputPort_, inputVc_, _port);
+  }
+}
+
+void AdaptiveAncestorRoutingAlgorithm::addPort(u32 _port, u32 _hops) {
+  if (routingModeIsPort(mode_)) {
+    // add the port as a whole
+    f64 cong = portCongestion(mode_, router_, inputPort_, inputVc_, _port);
+    reduction_->add(_port, U32_MAX, _hops, cong);
+  } else {
+    // add all VCs in the port
+    for (u32 vc = baseVc_; vc < baseVc_ + numVcs_; vc++) {
+      f64 cong = router_->congestionStatus(inputPort_, inputVc_, _port, vc);
+      reduction_->add(_port, vc, _hops, cong);
+    }
+  }
+}
+
+}  // namespace FatTree
+
+registerWithObjectFactory("adaptive_ancestor", FatTree::RoutingAlgorithm,
+                          FatTree::AdaptiveAncestorRoutingAlgorithm,
+                          FATTREE_ROUTINGALGORITHM_ARGS);
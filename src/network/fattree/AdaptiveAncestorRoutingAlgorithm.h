@@ -0,0 +1,76 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_FATTREE_ADAPTIVEANCESTORROUTINGALGORITHM_H_
+#define NETWORK_FATTREE_ADAPTIVEANCESTORROUTINGALGORITHM_H_
+
+#include <colhash/tuplehash.h>
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "event/Component.h"
+#include "network/fattree/RoutingAlgorithm.h"
+#include "router/Router.h"
+#include "routing/mode.h"
+#include "routing/Reduction.h"
+
+namespace FatTree {
+
+/*
+ * This algorithm routes up to a common ancestor like 'common_ancestor' but
+ *  chooses the up port by its congestion. The port given by a per-destination
+ *  hash is preferred while its congestion is within 'congestion_threshold' of
+ *  the least congested up port. When 'flowlet_timeout' is non-zero, packets of
+ *  a source/destination flow that arrive within that many cycles of the flow's
+ *  previous packet stick to its up port to limit reordering. The flowlets are
+ *  kept in a fixed size hashed table of 'flowlet_table_size' entries that is
+ *  shared by all input ports and VCs of the protocol class in the router.
+ */
+class AdaptiveAncestorRoutingAlgorithm : public RoutingAlgorithm {
+ public:
+  AdaptiveAncestorRoutingAlgorithm(
+      const std::string& _name, const Component* _parent, Router* _router,
+      u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
+      const std::vector<std::tuple<u32, u32, u32> >* _radices,
+      FlowletTable* _flowlets, Json::Value _settings);
+  ~AdaptiveAncestorRoutingAlgorithm();
+
+ protected:
+  void processRequest(
+      Flit* _flit, RoutingAlgorithm::Response* _response) override;
+
+ private:
+  u32 selectUpPort(u32 _destinationId, u32 _downPorts, u32 _upPorts);
+  f64 upPortCongestion(u32 _port) const;
+  void addPort(u32 _port, u32 _hops);
+
+  const RoutingMode mode_;
+  const bool leastCommonAncestor_;
+  const f64 congestionThreshold_;
+  const u64 flowletTimeout_;
+  const u32 flowletTableSize_;
+  const u64 random_;
+  Reduction* reduction_;
+  std::hash<std::tuple<u32, u64> > hasher_;
+  std::hash<std::tuple<u32, u32> > flowHasher_;
+  FlowletTable* flowlets_;
+};
+
+}  // namespace FatTree
+
+#endif  // NETWORK_FATTREE_ADAPTIVEANCESTORROUTINGALGORITHM_H_
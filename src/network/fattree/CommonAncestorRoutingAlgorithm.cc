@@ -32,9 +32,9 @@ CommonAncestorRoutingAlgorithm::CommonAncestorRoutingAlgorithm(
     const std::string& _name, const Component* _parent, Router* _router,
     u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
     const std::vector<std::tuple<u32, u32, u32> >* _radices,
-    Json::Value _settings)
+    FlowletTable* _flowlets, Json::Value _settings)
     : RoutingAlgorithm(_name, _parent, _router, _baseVc, _numVcs, _inputPort,
-                       _inputVc, _radices, _settings),
+                       _inputVc, _radices, _flowlets, _settings),
       mode_(parseRoutingMode(_settings["mode"].asString())),
       leastCommonAncestor_(_settings["least_common_ancestor"].asBool()),
       deterministic_(_settings["deterministic"].asBool()),
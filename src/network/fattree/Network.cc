@@ -77,6 +77,9 @@ Network::Network(const std::string& _name, const Component* _parent,
   // parse the protocol classes description
   loadProtocolClassInfo(_settings["protocol_classes"]);
 
+  // create the flowlet tables of the routing algorithms
+  flowletTables_.resize(numRouters() * protocolClassVcs_.size());
+
   // create all routers
   for (u32 level = 0; level < numLevels_; level++) {
     u32 levelRouters = routersAtLevel_.at(level);
@@ -249,10 +252,18 @@ Network::~Network() {
   const Network::RoutingAlgorithmInfo& info =
       routingAlgorithmInfo_.at(_inputVc);
 
+  // find the flowlet table of the router and protocol class
+  u32 pc = 0;
+  while (std::get<0>(protocolClassVcs_.at(pc)) != info.baseVc) {
+    pc++;
+  }
+  FlowletTable* flowlets =
+      &flowletTables_.at(_router->id() * protocolClassVcs_.size() + pc);
+
   // call the routing algorithm factory
   return RoutingAlgorithm::create(
       _name, _parent, _router, info.baseVc, info.numVcs, _inputPort, _inputVc,
-      &radices_, info.settings);
+      &radices_, flowlets, info.settings);
 }
 
 u32 Network::numRouters() const {
@@ -26,6 +26,7 @@
 #include "interface/Interface.h"
 #include "network/Channel.h"
 #include "network/Network.h"
+#include "network/fattree/RoutingAlgorithm.h"
 #include "router/Router.h"
 
 namespace FatTree {
@@ -68,6 +69,7 @@ class Network : public ::Network {
   std::vector<u32> routersAtLevelPerGroup_;
   std::vector<u32> totalGroups_;
   std::vector<std::tuple<u32, u32, u32> > radices_;  // down, up, total
+  std::vector<FlowletTable> flowletTables_;  // [router][protocol class]
 
   std::vector<std::vector<Router*> > routers_;
   std::vector<Interface*> interfaces_;
@@ -24,10 +24,10 @@ RoutingAlgorithm::RoutingAlgorithm(
     const std::string& _name, const Component* _parent,
     Router* _router, u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
     const std::vector<std::tuple<u32, u32, u32> >* _radices,
-    Json::Value _settings)
+    FlowletTable* _flowlets, Json::Value _settings)
     : ::RoutingAlgorithm(_name, _parent, _router, _baseVc, _numVcs, _inputPort,
                          _inputVc, _settings),
-      radices_(_radices) {}
+      radices_(_radices), flowletTable_(_flowlets) {}
 
 RoutingAlgorithm::~RoutingAlgorithm() {}
 
@@ -35,7 +35,7 @@ RoutingAlgorithm* RoutingAlgorithm::create(
     const std::string& _name, const Component* _parent, Router* _router,
     u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
     const std::vector<std::tuple<u32, u32, u32> >* _radices,
-    Json::Value _settings) {
+    FlowletTable* _flowlets, Json::Value _settings) {
   // retrieve the algorithm
   const std::string& algorithm = _settings["algorithm"].asString();
 
@@ -43,7 +43,7 @@ RoutingAlgorithm* RoutingAlgorithm::create(
   RoutingAlgorithm* ra = factory::ObjectFactory<
     RoutingAlgorithm, FATTREE_ROUTINGALGORITHM_ARGS>::create(
         algorithm, _name, _parent, _router, _baseVc, _numVcs, _inputPort,
-        _inputVc, _radices, _settings);
+        _inputVc, _radices, _flowlets, _settings);
 
   // check that the factory had this type
   if (ra == nullptr) {
@@ -28,17 +28,28 @@
 
 #define FATTREE_ROUTINGALGORITHM_ARGS                                 \
   const std::string&, const Component*, Router*, u32, u32, u32, u32,  \
-    const std::vector<std::tuple<u32, u32, u32> >*, Json::Value
+    const std::vector<std::tuple<u32, u32, u32> >*,                   \
+    FatTree::FlowletTable*, Json::Value
 
 namespace FatTree {
 
+// the network holds one flowlet table per router and protocol class, it is
+//  sized by the first routing algorithm that uses it
+struct Flowlet {
+  u32 source;
+  u32 destination;
+  u32 port;
+  u64 time;  // last cycle used
+};
+typedef std::vector<Flowlet> FlowletTable;
+
 class RoutingAlgorithm : public ::RoutingAlgorithm {
  public:
   RoutingAlgorithm(
       const std::string& _name, const Component* _parent,
       Router* _router, u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
       const std::vector<std::tuple<u32, u32, u32> >* _radices,
-      Json::Value _settings);
+      FlowletTable* _flowlets, Json::Value _settings);
   virtual ~RoutingAlgorithm();
 
   // this is a routing algorithm factory for the fat tree topology
@@ -46,6 +57,7 @@ class RoutingAlgorithm : public ::RoutingAlgorithm {
 
  protected:
   const std::vector<std::tuple<u32, u32, u32> >* radices_;
+  FlowletTable* flowletTable_;
 };
 
 }  // namespace FatTree
@@ -0,0 +1,139 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/graph/MinimalRoutingAlgorithm.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <cassert>
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "types/Message.h"
+#include "types/Packet.h"
+
+namespace Graph {
+
+MinimalRoutingAlgorithm::MinimalRoutingAlgorithm(
+    const std::string& _name, const Component* _parent, Router* _router,
+    u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
+    const RoutingTable* _routingTable, u32 _concentration,
+    Json::Value _settings)
+    : RoutingAlgorithm(_name, _parent, _router, _baseVc, _numVcs, _inputPort,
+                       _inputVc, _routingTable, _concentration, _settings),
+      mode_(parseRoutingMode(_settings["mode"].asString())) {
+  // one hop class per router-to-router hop of the longest minimal path
+  hopClasses_ = std::max(1u, routingTable_->diameter());
+  if (numVcs_ < hopClasses_) {
+    fprintf(stderr, "Graph minimal routing needs %u VCs for a diameter of "
+            "%u\n", hopClasses_, routingTable_->diameter());
+    assert(false);
+  }
+
+  // create the reduction
+  reduction_ = Reduction::create("Reduction", this, _router, mode_, true,
+                                 _settings["reduction"]);
+}
+
+MinimalRoutingAlgorithm::~MinimalRoutingAlgorithm() {
+  delete reduction_;
+}
+
+void MinimalRoutingAlgorithm::processRequest(
+    Flit* _flit, RoutingAlgorithm::Response* _response) {
+  // interface ids are router-major: router * concentration + terminal
+  u32 destinationId = _flit->packet()->message()->getDestinationId();
+  u32 thisRouter = router_->id();
+  u32 destinationRouter = destinationId / concentration_;
+
+  if (thisRouter == destinationRouter) {
+    // exit - to terminal
+    addPort(destinationId % concentration_, 1, U32_MAX);
+  } else {
+    // the hop class follows the one the flit arrived on
+    u32 hopClass = 0;
+    if (inputPort_ >= concentration_) {
+      hopClass = ((_flit->getVc() - baseVc_) % hopClasses_) + 1;
+    }
+    assert(hopClass < hopClasses_);
+
+    // all minimal next hops
+    u32 hops = routingTable_->distance(thisRouter, destinationRouter) + 1;
+    std::vector<u32> ports;
+    routingTable_->minimalPorts(thisRouter, destinationRouter, &ports);
+    assert(!ports.empty());
+    for (u32 port : ports) {
+      addPort(port, hops, hopClass);
+    }
+  }
+
+  // reduction phase
+  const std::unordered_set<std::tuple<u32, u32> >* outputs =
+      reduction_->reduce(nullptr);
+  for (const auto& t : *outputs) {
+    u32 port = std::get<0>(t);
+    if (routingModeIsPort(mode_)) {
+      // port mode, add all VCs of the hop class
+      u32 hopClass = std::get<1>(t);
+      if (hopClass != U32_MAX) {
+        for (u32 vc = baseVc_ + hopClass; vc < baseVc_ + numVcs_;
+             vc += hopClasses_) {
+          _response->add(port, vc);
+        }
+      } else {
+        // exit - all VCs
+        for (u32 vc = baseVc_; vc < baseVc_ + numVcs_; vc++) {
+          _response->add(port, vc);
+        }
+      }
+    } else {
+      // vc mode
+      u32 vc = std::get<1>(t);
+      _response->add(port, vc);
+    }
+  }
+}
+
+void MinimalRoutingAlgorithm::addPort(u32 _port, u32 _hops, u32 _hopClass) {
+  if (routingModeIsPort(mode_)) {
+    // port mode
+    f64 cong = portCongestion(mode_, router_, inputPort_, inputVc_, _port);
+    reduction_->add(_port, _hopClass, _hops, cong);
+  } else {
+    // vc mode
+    if (_hopClass == U32_MAX) {
+      // add all VCs in the port
+      for (u32 vc = baseVc_; vc < baseVc_ + numVcs_; vc++) {
+        f64 cong = router_->congestionStatus(inputPort_, inputVc_, _port, vc);
+        reduction_->add(_port, vc, _hops, cong);
+      }
+    } else {
+      // add all VCs in the hop class
+      for (u32 vc = baseVc_ + _hopClass; vc < baseVc_ + numVcs_;
+           vc += hopClasses_) {
+        f64 cong = router_->congestionStatus(inputPort_, inputVc_, _port, vc);
+        reduction_->add(_port, vc, _hops, cong);
+      }
+    }
+  }
+}
+
+}  // namespace Graph
+
+registerWithObjectFactory("minimal", Graph::RoutingAlgorithm,
+                          Graph::MinimalRoutingAlgorithm,
+                          GRAPH_ROUTINGALGORITHM_ARGS);
@@ -0,0 +1,255 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/graph/Network.h"
+
+#include <factory/ObjectFactory.h>
+#include <fio/InFile.h>
+#include <strop/strop.h>
+
+#include <cassert>
+
+#include "network/graph/RoutingAlgorithm.h"
+
+namespace Graph {
+
+Network::Network(const std::string& _name, const Component* _parent,
+                 MetadataHandler* _metadataHandler, Json::Value _settings)
+    : ::Network(_name, _parent, _metadataHandler, _settings) {
+  // routers and concentration
+  assert(_settings.isMember("num_routers"));
+  numRouters_ = _settings["num_routers"].asUInt();
+  assert(numRouters_ > 0);
+  assert(_settings.isMember("concentration"));
+  concentration_ = _settings["concentration"].asUInt();
+  assert(concentration_ > 0);
+
+  // channels
+  assert(_settings.isMember("internal_channel"));
+  assert(_settings.isMember("external_channel"));
+
+  // read the links and give each one a port on both routers
+  assert(_settings.isMember("edge_file") && _settings["edge_file"].isString());
+  std::vector<Link> links;
+  loadEdges(_settings["edge_file"].asString(), &links);
+  std::vector<std::vector<u32> > neighbors(numRouters_);
+  std::vector<std::vector<u32> > linkPorts(links.size());
+  for (u32 idx = 0; idx < links.size(); idx++) {
+    const Link& link = links.at(idx);
+    linkPorts.at(idx).push_back(
+        concentration_ + neighbors.at(link.source).size());
+    neighbors.at(link.source).push_back(link.destination);
+    linkPorts.at(idx).push_back(
+        concentration_ + neighbors.at(link.destination).size());
+    neighbors.at(link.destination).push_back(link.source);
+  }
+
+  // compute the minimal routing tables
+  assert(_settings.isMember("table_threads") &&
+         _settings["table_threads"].isUInt());
+  routingTable_ = new RoutingTable(neighbors, concentration_,
+                                   _settings["table_threads"].asUInt());
+
+  // parse the protocol classes description
+  loadProtocolClassInfo(_settings["protocol_classes"]);
+
+  // create routers
+  routers_.resize(numRouters_, nullptr);
+  for (u32 id = 0; id < numRouters_; id++) {
+    std::vector<u32> routerAddress;
+    translateRouterIdToAddress(id, &routerAddress);
+    std::string routerName =
+        "Router_" + strop::vecString<u32>(routerAddress, '-');
+    u32 routerRadix = concentration_ + neighbors.at(id).size();
+    routers_.at(id) = Router::create(
+        routerName, this, this, id, routerAddress, routerRadix, numVcs_,
+        protocolClassVcs_, _metadataHandler, _settings["router"]);
+  }
+
+  // create internal channels, two per link
+  for (u32 idx = 0; idx < links.size(); idx++) {
+    const Link& link = links.at(idx);
+    _settings["internal_channel"]["latency"] = link.latency;
+    for (u32 dir = 0; dir < 2; dir++) {
+      u32 src = (dir == 0) ? link.source : link.destination;
+      u32 dst = (dir == 0) ? link.destination : link.source;
+      u32 srcPort = linkPorts.at(idx).at(dir);
+      u32 dstPort = linkPorts.at(idx).at(1 - dir);
+
+      std::string channelName =
+          "Channel_" + std::to_string(src) + "-to-" + std::to_string(dst) +
+          "-" + std::to_string(idx);
+      Channel* channel = new Channel(channelName, this, numVcs_,
+                                     _settings["internal_channel"]);
+      internalChannels_.push_back(channel);
+
+      routers_.at(src)->setOutputChannel(srcPort, channel);
+      routers_.at(dst)->setInputChannel(dstPort, channel);
+    }
+  }
+
+  // create interfaces and link them with the routers
+  interfaces_.resize(numRouters_ * concentration_, nullptr);
+  for (u32 id = 0; id < interfaces_.size(); id++) {
+    std::vector<u32> interfaceAddress;
+    translateInterfaceIdToAddress(id, &interfaceAddress);
+    u32 conc = interfaceAddress.at(0);
+    Router* router = routers_.at(interfaceAddress.at(1));
+
+    std::string interfaceName =
+        "Interface_" + strop::vecString<u32>(interfaceAddress, '-');
+    Interface* interface = Interface::create(
+        interfaceName, this, id, interfaceAddress, numVcs_,
+        protocolClassVcs_, _metadataHandler, _settings["interface"]);
+    interfaces_.at(id) = interface;
+
+    // create I/O channels
+    std::string inChannelName =
+        "Channel_" + strop::vecString<u32>(interfaceAddress, '-') + "-to-" +
+        strop::vecString<u32>(router->address(), '-');
+    std::string outChannelName =
+        "Channel_" + strop::vecString<u32>(router->address(), '-') + "-to-" +
+        strop::vecString<u32>(interfaceAddress, '-');
+    Channel* inChannel = new Channel(inChannelName, this, numVcs_,
+                                     _settings["external_channel"]);
+    Channel* outChannel = new Channel(outChannelName, this, numVcs_,
+                                      _settings["external_channel"]);
+    externalChannels_.push_back(inChannel);
+    externalChannels_.push_back(outChannel);
+
+    // link with router
+    router->setInputChannel(conc, inChannel);
+    interface->setOutputChannel(0, inChannel);
+    router->setOutputChannel(conc, outChannel);
+    interface->setInputChannel(0, outChannel);
+  }
+
+  // clear the protocol class info
+  clearProtocolClassInfo();
+}
+
+Network::~Network() {
+  for (Router* router : routers_) {
+    delete router;
+  }
+  for (Interface* interface : interfaces_) {
+    delete interface;
+  }
+  for (Channel* channel : internalChannels_) {
+    delete channel;
+  }
+  for (Channel* channel : externalChannels_) {
+    delete channel;
+  }
+  delete routingTable_;
+}
+
+::RoutingAlgorithm* Network::createRoutingAlgorithm(
+     u32 _inputPort, u32 _inputVc, const std::string& _name,
+     const Component* _parent, Router* _router) {
+  // get the info
+  const Network::RoutingAlgorithmInfo& info =
+      routingAlgorithmInfo_.at(_inputVc);
+
+  // call the routing algorithm factory
+  return RoutingAlgorithm::create(
+      _name, _parent, _router, info.baseVc, info.numVcs, _inputPort, _inputVc,
+      routingTable_, concentration_, info.settings);
+}
+
+u32 Network::numRouters() const {
+  return numRouters_;
+}
+
+u32 Network::numInterfaces() const {
+  return numRouters_ * concentration_;
+}
+
+Router* Network::getRouter(u32 _id) const {
+  return routers_.at(_id);
+}
+
+Interface* Network::getInterface(u32 _id) const {
+  return interfaces_.at(_id);
+}
+
+void Network::translateInterfaceIdToAddress(
+    u32 _id, std::vector<u32>* _address) const {
+  _address->resize(2);
+  _address->at(0) = _id % concentration_;
+  _address->at(1) = _id / concentration_;
+}
+
+u32 Network::translateInterfaceAddressToId(
+    const std::vector<u32>* _address) const {
+  return (_address->at(1) * concentration_) + _address->at(0);
+}
+
+void Network::translateRouterIdToAddress(
+    u32 _id, std::vector<u32>* _address) const {
+  _address->resize(1);
+  _address->at(0) = _id;
+}
+
+u32 Network::translateRouterAddressToId(
+    const std::vector<u32>* _address) const {
+  return _address->at(0);
+}
+
+u32 Network::computeMinimalHops(const std::vector<u32>* _source,
+                                const std::vector<u32>* _destination) const {
+  return routingTable_->distance(_source->at(1), _destination->at(1)) + 1;
+}
+
+void Network::collectChannels(std::vector<Channel*>* _channels) {
+  for (Channel* channel : externalChannels_) {
+    _channels->push_back(channel);
+  }
+  for (Channel* channel : internalChannels_) {
+    _channels->push_back(channel);
+  }
+}
+
+void Network::loadEdges(const std::string& _filename,
+                        std::vector<Link>* _links) {
+  fio::InFile inf(_filename);
+  std::string line;
+  fio::InFile::Status sts = fio::InFile::Status::OK;
+  while (sts == fio::InFile::Status::OK) {
+    sts = inf.getLine(&line);
+    assert(sts != fio::InFile::Status::ERROR);
+    if ((sts == fio::InFile::Status::OK) && (line.size() > 0)) {
+      std::vector<std::string> strs = strop::split(line, ',');
+      if (strs.size() != 3) {
+        fprintf(stderr, "invalid edge: %s\n", line.c_str());
+        assert(false);
+      }
+      Link link;
+      link.source = std::stoul(strs.at(0));
+      link.destination = std::stoul(strs.at(1));
+      link.latency = std::stoul(strs.at(2));
+      if ((link.source >= numRouters_) || (link.destination >= numRouters_) ||
+          (link.source == link.destination) || (link.latency == 0)) {
+        fprintf(stderr, "invalid edge: %s\n", line.c_str());
+        assert(false);
+      }
+      _links->push_back(link);
+    }
+  }
+}
+
+}  // namespace Graph
+
+registerWithObjectFactory("graph", ::Network,
+                          Graph::Network, NETWORK_ARGS);
@@ -0,0 +1,158 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/graph/RoutingTable.h"
+
+#include <cassert>
+#include <cstdio>
+
+#include <algorithm>
+#include <thread>
+
+namespace Graph {
+
+RoutingTable::RoutingTable(const std::vector<std::vector<u32> >& _neighbors,
+                           u32 _portBase, u32 _threads)
+    : neighbors_(_neighbors), portBase_(_portBase),
+      numRouters_(_neighbors.size()), diameter_(0) {
+  assert(numRouters_ > 0);
+
+  // determine the number of threads to use
+  u32 threads = _threads;
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threads = std::min(threads, numRouters_);
+
+  // lay out the port bit sets, each router uses as many words as it needs
+  setWords_.resize(numRouters_);
+  setOffsets_.resize(numRouters_);
+  u64 words = 0;
+  for (u32 router = 0; router < numRouters_; router++) {
+    setWords_.at(router) = (neighbors_.at(router).size() + 63) / 64;
+    setOffsets_.at(router) = words;
+    words += (u64)setWords_.at(router) * numRouters_;
+  }
+
+  // each phase partitions the routers into contiguous blocks for the threads,
+  //  the port sets need the distances of all routers
+  distances_.resize((u64)numRouters_ * numRouters_, U16_MAX);
+  portSets_.resize(words, 0);
+  for (u32 phase = 0; phase < 2; phase++) {
+    std::vector<std::thread> workers;
+    u32 block = (numRouters_ + threads - 1) / threads;
+    for (u32 first = 0; first < numRouters_; first += block) {
+      u32 last = std::min(first + block, numRouters_);
+      if (phase == 0) {
+        workers.emplace_back(&RoutingTable::computeDistances, this, first,
+                             last);
+      } else {
+        workers.emplace_back(&RoutingTable::computePorts, this, first, last);
+      }
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+  // check connectivity and find the diameter
+  for (u16 distance : distances_) {
+    if (distance == U16_MAX) {
+      fprintf(stderr, "the router graph is not connected\n");
+      assert(false);
+    }
+    diameter_ = std::max(diameter_, (u32)distance);
+  }
+}
+
+RoutingTable::~RoutingTable() {}
+
+u32 RoutingTable::numRouters() const {
+  return numRouters_;
+}
+
+u32 RoutingTable::diameter() const {
+  return diameter_;
+}
+
+u32 RoutingTable::distance(u32 _source, u32 _destination) const {
+  assert(_source < numRouters_);
+  assert(_destination < numRouters_);
+  return distances_[(u64)_source * numRouters_ + _destination];
+}
+
+void RoutingTable::minimalPorts(u32 _router, u32 _destination,
+                                std::vector<u32>* _ports) const {
+  assert(_router < numRouters_);
+  assert(_destination < numRouters_);
+  u32 words = setWords_[_router];
+  const u64* set = &portSets_[setOffsets_[_router] +
+                              (u64)_destination * words];
+  for (u32 word = 0; word < words; word++) {
+    u64 bits = set[word];
+    while (bits != 0) {
+      u32 bit = __builtin_ctzll(bits);
+      bits &= bits - 1;
+      _ports->push_back(portBase_ + (word * 64) + bit);
+    }
+  }
+}
+
+void RoutingTable::computeDistances(u32 _first, u32 _last) {
+  // breadth-first search from each router of the block
+  std::vector<u32> frontier;
+  std::vector<u32> next;
+  for (u32 source = _first; source < _last; source++) {
+    u16* row = &distances_[(u64)source * numRouters_];
+    row[source] = 0;
+    frontier.assign(1, source);
+    for (u32 distance = 1; !frontier.empty(); distance++) {
+      assert(distance < U16_MAX);
+      next.clear();
+      for (u32 router : frontier) {
+        for (u32 neighbor : neighbors_[router]) {
+          if (row[neighbor] == U16_MAX) {
+            row[neighbor] = distance;
+            next.push_back(neighbor);
+          }
+        }
+      }
+      frontier.swap(next);
+    }
+  }
+}
+
+void RoutingTable::computePorts(u32 _first, u32 _last) {
+  // a port is minimal if its neighbor is one hop closer to the destination,
+  //  links are bidirectional so distances are symmetric
+  for (u32 router = _first; router < _last; router++) {
+    const std::vector<u32>& neighbors = neighbors_[router];
+    u32 words = setWords_[router];
+    for (u32 destination = 0; destination < numRouters_; destination++) {
+      u16 distance = distances_[(u64)destination * numRouters_ + router];
+      if ((distance == 0) || (distance == U16_MAX)) {
+        continue;
+      }
+      u64* set = &portSets_[setOffsets_[router] + (u64)destination * words];
+      const u16* row = &distances_[(u64)destination * numRouters_];
+      for (u32 port = 0; port < neighbors.size(); port++) {
+        if (row[neighbors[port]] == distance - 1) {
+          set[port / 64] |= (u64)1 << (port % 64);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace Graph
@@ -0,0 +1,68 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_GRAPH_ROUTINGTABLE_H_
+#define NETWORK_GRAPH_ROUTINGTABLE_H_
+
+#include <prim/prim.h>
+
+#include <vector>
+
+namespace Graph {
+
+/*
+ * This holds the all-pairs minimal routing information of a graph of routers.
+ *  The distances are a router by router matrix of hop counts. The minimal
+ *  next hops of each router are a bit set of its network ports per
+ *  destination router. Both are computed at construction by breadth-first
+ *  searches spread over '_threads' threads (0 uses all hardware threads).
+ *
+ * '_neighbors' holds, per router, the router reached by each of its network
+ *  ports. Network port 'p' is router port '_portBase' + 'p'. Links must be
+ *  bidirectional and the graph must be connected.
+ */
+class RoutingTable {
+ public:
+  RoutingTable(const std::vector<std::vector<u32> >& _neighbors,
+               u32 _portBase, u32 _threads);
+  ~RoutingTable();
+
+  u32 numRouters() const;
+  u32 diameter() const;
+
+  // router-to-router hops between two routers
+  u32 distance(u32 _source, u32 _destination) const;
+
+  // the router ports of '_router' that are on a minimal path to '_destination'
+  void minimalPorts(u32 _router, u32 _destination,
+                    std::vector<u32>* _ports) const;
+
+ private:
+  void computeDistances(u32 _first, u32 _last);
+  void computePorts(u32 _first, u32 _last);
+
+  const std::vector<std::vector<u32> > neighbors_;
+  const u32 portBase_;
+  const u32 numRouters_;
+  u32 diameter_;
+
+  std::vector<u16> distances_;  // [source * numRouters_ + destination]
+  std::vector<u32> setWords_;  // words of each port bit set of a router
+  std::vector<u64> setOffsets_;  // first word of the bit sets of a router
+  std::vector<u64> portSets_;
+};
+
+}  // namespace Graph
+
+#endif  // NETWORK_GRAPH_ROUTINGTABLE_H_
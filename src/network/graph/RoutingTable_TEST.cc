@@ -0,0 +1,101 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/graph/RoutingTable.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <algorithm>
+#include <vector>
+
+TEST(GraphRoutingTable, ring) {
+  // a ring of 6 routers, port 0 goes right and port 1 goes left
+  const u32 numRouters = 6;
+  const u32 portBase = 2;
+  std::vector<std::vector<u32> > neighbors(numRouters);
+  for (u32 r = 0; r < numRouters; r++) {
+    neighbors.at(r).push_back((r + 1) % numRouters);
+    neighbors.at(r).push_back((r + numRouters - 1) % numRouters);
+  }
+
+  for (u32 threads = 1; threads <= 4; threads++) {
+    Graph::RoutingTable table(neighbors, portBase, threads);
+    ASSERT_EQ(table.numRouters(), numRouters);
+    ASSERT_EQ(table.diameter(), 3u);
+
+    for (u32 src = 0; src < numRouters; src++) {
+      for (u32 dst = 0; dst < numRouters; dst++) {
+        u32 right = (dst + numRouters - src) % numRouters;
+        u32 left = (src + numRouters - dst) % numRouters;
+        ASSERT_EQ(table.distance(src, dst), std::min(right, left));
+
+        std::vector<u32> exp;
+        if ((right != 0) && (right <= left)) {
+          exp.push_back(portBase + 0);
+        }
+        if ((left != 0) && (left <= right)) {
+          exp.push_back(portBase + 1);
+        }
+        std::vector<u32> act;
+        table.minimalPorts(src, dst, &act);
+        ASSERT_EQ(act, exp);
+      }
+    }
+  }
+}
+
+TEST(GraphRoutingTable, parallelLinks) {
+  // router 0 has two links to router 1 and one to router 2, router 1 and
+  //  router 2 are linked. router 3 has 70 links to router 2 which spans
+  //  several words of port bits.
+  std::vector<std::vector<u32> > neighbors(4);
+  neighbors.at(0) = {1, 1, 2};
+  neighbors.at(1) = {0, 0, 2};
+  neighbors.at(2) = {0, 1};
+  for (u32 link = 0; link < 70; link++) {
+    neighbors.at(2).push_back(3);
+    neighbors.at(3).push_back(2);
+  }
+
+  Graph::RoutingTable table(neighbors, 1, 0);
+  ASSERT_EQ(table.diameter(), 2u);
+  ASSERT_EQ(table.distance(0, 3), 2u);
+  ASSERT_EQ(table.distance(3, 1), 2u);
+
+  std::vector<u32> ports;
+  table.minimalPorts(0, 1, &ports);
+  ASSERT_EQ(ports, std::vector<u32>({1, 2}));
+
+  ports.clear();
+  table.minimalPorts(0, 3, &ports);
+  ASSERT_EQ(ports, std::vector<u32>({3}));
+
+  ports.clear();
+  table.minimalPorts(0, 0, &ports);
+  ASSERT_TRUE(ports.empty());
+
+  ports.clear();
+  table.minimalPorts(3, 0, &ports);
+  ASSERT_EQ(ports.size(), 70u);
+  for (u32 idx = 0; idx < ports.size(); idx++) {
+    ASSERT_EQ(ports.at(idx), 1 + idx);
+  }
+
+  ports.clear();
+  table.minimalPorts(2, 3, &ports);
+  ASSERT_EQ(ports.size(), 70u);
+  ASSERT_EQ(ports.front(), 1u + 2);
+  ASSERT_EQ(ports.back(), 1u + 71);
+}
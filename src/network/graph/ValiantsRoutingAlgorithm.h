@@ -0,0 +1,60 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_GRAPH_VALIANTSROUTINGALGORITHM_H_
+#define NETWORK_GRAPH_VALIANTSROUTINGALGORITHM_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+
+#include "event/Component.h"
+#include "network/graph/RoutingAlgorithm.h"
+#include "router/Router.h"
+#include "routing/mode.h"
+#include "routing/Reduction.h"
+
+namespace Graph {
+
+/*
+ * This routes minimally to a random intermediate router then minimally to
+ *  the destination. As with minimal routing the h-th router-to-router hop
+ *  uses the VCs of hop class 'h', which needs at least twice as many VCs as
+ *  the diameter of the graph.
+ */
+class ValiantsRoutingAlgorithm : public RoutingAlgorithm {
+ public:
+  ValiantsRoutingAlgorithm(
+      const std::string& _name, const Component* _parent, Router* _router,
+      u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
+      const RoutingTable* _routingTable, u32 _concentration,
+      Json::Value _settings);
+  ~ValiantsRoutingAlgorithm();
+
+ protected:
+  void processRequest(
+      Flit* _flit, RoutingAlgorithm::Response* _response) override;
+
+ private:
+  void addPort(u32 _port, u32 _hops, u32 _hopClass);
+
+  u32 hopClasses_;
+  const RoutingMode mode_;
+  Reduction* reduction_;
+};
+
+}  // namespace Graph
+
+#endif  // NETWORK_GRAPH_VALIANTSROUTINGALGORITHM_H_
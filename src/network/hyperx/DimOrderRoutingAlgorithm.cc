@@ -69,6 +69,10 @@ DimOrderRoutingAlgorithm::DimOrderRoutingAlgorithm(
 
 DimOrderRoutingAlgorithm::~DimOrderRoutingAlgorithm() {}
 
+bool DimOrderRoutingAlgorithm::supportsLookahead() const {
+  return true;
+}
+
 void DimOrderRoutingAlgorithm::processRequest(
     Flit* _flit, RoutingAlgorithm::Response* _response) {
   const std::vector<u32>* destinationAddress =
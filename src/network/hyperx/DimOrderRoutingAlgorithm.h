@@ -41,6 +41,8 @@ class DimOrderRoutingAlgorithm : public RoutingAlgorithm {
       Json::Value _settings);
   ~DimOrderRoutingAlgorithm();
 
+  bool supportsLookahead() const override;
+
  protected:
   void processRequest(Flit* _flit,
                       RoutingAlgorithm::Response* _response) override;
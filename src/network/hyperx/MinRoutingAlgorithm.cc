@@ -97,6 +97,10 @@ MinRoutingAlgorithm::MinRoutingAlgorithm(
 
 MinRoutingAlgorithm::~MinRoutingAlgorithm() {}
 
+bool MinRoutingAlgorithm::supportsLookahead() const {
+  return true;
+}
+
 void MinRoutingAlgorithm::processRequest(
     Flit* _flit, RoutingAlgorithm::Response* _response) {
   const std::vector<u32>* destinationAddress =
@@ -41,6 +41,8 @@ class MinRoutingAlgorithm : public RoutingAlgorithm {
       u32 _concentration, Json::Value _settings);
   ~MinRoutingAlgorithm();
 
+  bool supportsLookahead() const override;
+
  protected:
   void processRequest(Flit* _flit,
                       RoutingAlgorithm::Response* _response) override;
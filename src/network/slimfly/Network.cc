@@ -0,0 +1,232 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/slimfly/Network.h"
+
+#include <factory/ObjectFactory.h>
+#include <strop/strop.h>
+
+#include <cassert>
+
+#include <algorithm>
+
+#include "network/graph/RoutingAlgorithm.h"
+#include "network/slimfly/util.h"
+
+namespace SlimFly {
+
+Network::Network(const std::string& _name, const Component* _parent,
+                 MetadataHandler* _metadataHandler, Json::Value _settings)
+    : ::Network(_name, _parent, _metadataHandler, _settings) {
+  // prime power and concentration
+  assert(_settings.isMember("q"));
+  q_ = _settings["q"].asUInt();
+  u32 prime, power;
+  if (!factorPrimePower(q_, &prime, &power) || (q_ < 3)) {
+    fprintf(stderr, "Slim Fly needs q to be a prime power of at least 3, "
+            "q=%u\n", q_);
+    assert(false);
+  }
+  assert(_settings.isMember("concentration"));
+  concentration_ = _settings["concentration"].asUInt();
+  assert(concentration_ > 0);
+
+  // channels
+  assert(_settings.isMember("internal_channel"));
+  assert(_settings.isMember("external_channel"));
+
+  // build the MMS graph and its minimal routing tables
+  std::vector<std::vector<u32> > neighbors;
+  createNeighbors(q_, &neighbors);
+  assert(_settings.isMember("table_threads") &&
+         _settings["table_threads"].isUInt());
+  routingTable_ = new Graph::RoutingTable(
+      neighbors, concentration_, _settings["table_threads"].asUInt());
+  assert(routingTable_->diameter() == 2);
+
+  // parse the protocol classes description
+  loadProtocolClassInfo(_settings["protocol_classes"]);
+
+  // create routers
+  u32 routerRadix = concentration_ + computeNetworkRadix(q_);
+  routers_.resize(neighbors.size(), nullptr);
+  for (u32 id = 0; id < routers_.size(); id++) {
+    std::vector<u32> routerAddress;
+    translateRouterIdToAddress(id, &routerAddress);
+    std::string routerName =
+        "Router_" + strop::vecString<u32>(routerAddress, '-');
+    routers_.at(id) = Router::create(
+        routerName, this, this, id, routerAddress, routerRadix, numVcs_,
+        protocolClassVcs_, _metadataHandler, _settings["router"]);
+  }
+
+  // create internal channels, one per direction of each link
+  for (u32 src = 0; src < routers_.size(); src++) {
+    for (u32 idx = 0; idx < neighbors.at(src).size(); idx++) {
+      u32 dst = neighbors.at(src).at(idx);
+      const std::vector<u32>& back = neighbors.at(dst);
+      u32 srcPort = concentration_ + idx;
+      u32 dstPort = concentration_ + static_cast<u32>(
+          std::find(back.begin(), back.end(), src) - back.begin());
+      assert(dstPort < routerRadix);
+
+      std::string channelName =
+          "Channel_" + strop::vecString<u32>(routers_.at(src)->address(), '-') +
+          "-to-" + strop::vecString<u32>(routers_.at(dst)->address(), '-');
+      Channel* channel = new Channel(channelName, this, numVcs_,
+                                     _settings["internal_channel"]);
+      internalChannels_.push_back(channel);
+
+      routers_.at(src)->setOutputChannel(srcPort, channel);
+      routers_.at(dst)->setInputChannel(dstPort, channel);
+    }
+  }
+
+  // create interfaces and link them with the routers
+  interfaces_.resize(routers_.size() * concentration_, nullptr);
+  for (u32 id = 0; id < interfaces_.size(); id++) {
+    std::vector<u32> interfaceAddress;
+    translateInterfaceIdToAddress(id, &interfaceAddress);
+    u32 conc = interfaceAddress.at(0);
+    Router* router = routers_.at(id / concentration_);
+
+    std::string interfaceName =
+        "Interface_" + strop::vecString<u32>(interfaceAddress, '-');
+    Interface* interface = Interface::create(
+        interfaceName, this, id, interfaceAddress, numVcs_,
+        protocolClassVcs_, _metadataHandler, _settings["interface"]);
+    interfaces_.at(id) = interface;
+
+    // create I/O channels
+    std::string inChannelName =
+        "Channel_" + strop::vecString<u32>(interfaceAddress, '-') + "-to-" +
+        strop::vecString<u32>(router->address(), '-');
+    std::string outChannelName =
+        "Channel_" + strop::vecString<u32>(router->address(), '-') + "-to-" +
+        strop::vecString<u32>(interfaceAddress, '-');
+    Channel* inChannel = new Channel(inChannelName, this, numVcs_,
+                                     _settings["external_channel"]);
+    Channel* outChannel = new Channel(outChannelName, this, numVcs_,
+                                      _settings["external_channel"]);
+    externalChannels_.push_back(inChannel);
+    externalChannels_.push_back(outChannel);
+
+    // link with router
+    router->setInputChannel(conc, inChannel);
+    interface->setOutputChannel(0, inChannel);
+    router->setOutputChannel(conc, outChannel);
+    interface->setInputChannel(0, outChannel);
+  }
+
+  // clear the protocol class info
+  clearProtocolClassInfo();
+}
+
+Network::~Network() {
+  for (Router* router : routers_) {
+    delete router;
+  }
+  for (Interface* interface : interfaces_) {
+    delete interface;
+  }
+  for (Channel* channel : internalChannels_) {
+    delete channel;
+  }
+  for (Channel* channel : externalChannels_) {
+    delete channel;
+  }
+  delete routingTable_;
+}
+
+::RoutingAlgorithm* Network::createRoutingAlgorithm(
+     u32 _inputPort, u32 _inputVc, const std::string& _name,
+     const Component* _parent, Router* _router) {
+  // get the info
+  const Network::RoutingAlgorithmInfo& info =
+      routingAlgorithmInfo_.at(_inputVc);
+
+  // call the graph routing algorithm factory
+  return Graph::RoutingAlgorithm::create(
+      _name, _parent, _router, info.baseVc, info.numVcs, _inputPort, _inputVc,
+      routingTable_, concentration_, info.settings);
+}
+
+u32 Network::numRouters() const {
+  return routers_.size();
+}
+
+u32 Network::numInterfaces() const {
+  return interfaces_.size();
+}
+
+Router* Network::getRouter(u32 _id) const {
+  return routers_.at(_id);
+}
+
+Interface* Network::getInterface(u32 _id) const {
+  return interfaces_.at(_id);
+}
+
+void Network::translateInterfaceIdToAddress(
+    u32 _id, std::vector<u32>* _address) const {
+  std::vector<u32> routerAddress;
+  translateRouterIdToAddress(_id / concentration_, &routerAddress);
+  _address->resize(4);
+  _address->at(0) = _id % concentration_;
+  std::copy(routerAddress.begin(), routerAddress.end(),
+            _address->begin() + 1);
+}
+
+u32 Network::translateInterfaceAddressToId(
+    const std::vector<u32>* _address) const {
+  std::vector<u32> routerAddress(_address->begin() + 1, _address->end());
+  return (translateRouterAddressToId(&routerAddress) * concentration_) +
+      _address->at(0);
+}
+
+void Network::translateRouterIdToAddress(
+    u32 _id, std::vector<u32>* _address) const {
+  _address->resize(3);
+  _address->at(0) = _id % q_;
+  _address->at(1) = (_id / q_) % q_;
+  _address->at(2) = _id / (q_ * q_);
+}
+
+u32 Network::translateRouterAddressToId(
+    const std::vector<u32>* _address) const {
+  return computeRouterId(q_, _address->at(2), _address->at(1),
+                         _address->at(0));
+}
+
+u32 Network::computeMinimalHops(const std::vector<u32>* _source,
+                                const std::vector<u32>* _destination) const {
+  u32 source = translateInterfaceAddressToId(_source) / concentration_;
+  u32 destination = translateInterfaceAddressToId(_destination) /
+      concentration_;
+  return routingTable_->distance(source, destination) + 1;
+}
+
+void Network::collectChannels(std::vector<Channel*>* _channels) {
+  for (Channel* channel : externalChannels_) {
+    _channels->push_back(channel);
+  }
+  for (Channel* channel : internalChannels_) {
+    _channels->push_back(channel);
+  }
+}
+
+}  // namespace SlimFly
+
+registerWithObjectFactory("slimfly", ::Network,
+                          SlimFly::Network, NETWORK_ARGS);
@@ -0,0 +1,85 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_SLIMFLY_NETWORK_H_
+#define NETWORK_SLIMFLY_NETWORK_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+#include "event/Component.h"
+#include "interface/Interface.h"
+#include "network/Channel.h"
+#include "network/graph/RoutingTable.h"
+#include "network/Network.h"
+#include "router/Router.h"
+
+namespace SlimFly {
+
+/*
+ * This is the diameter-2 Slim Fly built from the McKay-Miller-Siran graph of
+ *  the prime power 'q'. It has 2q^2 routers (s,x,y) each with (3q - delta)/2
+ *  router-to-router ports. Router ports [0,concentration) connect the
+ *  interfaces, the following ports are the links in the order of
+ *  createNeighbors(). Routers are addressed as [y,x,s] and interfaces as
+ *  [c,y,x,s]. Routing uses the graph routing algorithms on a routing table of
+ *  the MMS graph.
+ */
+class Network : public ::Network {
+ public:
+  Network(const std::string& _name, const Component* _parent,
+          MetadataHandler* _metadataHandler, Json::Value _settings);
+  ~Network();
+
+  // this is the routing algorithm factory for this network
+  ::RoutingAlgorithm* createRoutingAlgorithm(
+       u32 _inputPort, u32 _inputVc, const std::string& _name,
+       const Component* _parent, Router* _router) override;
+
+  // Network
+  u32 numRouters() const override;
+  u32 numInterfaces() const override;
+  Router* getRouter(u32 _id) const override;
+  Interface* getInterface(u32 _id) const override;
+  void translateInterfaceIdToAddress(
+      u32 _id, std::vector<u32>* _address) const override;
+  u32 translateInterfaceAddressToId(
+      const std::vector<u32>* _address) const override;
+  void translateRouterIdToAddress(
+      u32 _id, std::vector<u32>* _address) const override;
+  u32 translateRouterAddressToId(
+      const std::vector<u32>* _address) const override;
+  u32 computeMinimalHops(const std::vector<u32>* _source,
+                         const std::vector<u32>* _destination) const override;
+
+ protected:
+  void collectChannels(std::vector<Channel*>* _channels) override;
+
+ private:
+  u32 q_;
+  u32 concentration_;
+  Graph::RoutingTable* routingTable_;
+
+  std::vector<Router*> routers_;
+  std::vector<Interface*> interfaces_;
+  std::vector<Channel*> internalChannels_;
+  std::vector<Channel*> externalChannels_;
+};
+
+}  // namespace SlimFly
+
+#endif  // NETWORK_SLIMFLY_NETWORK_H_
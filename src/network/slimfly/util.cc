@@ -0,0 +1,238 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/slimfly/util.h"
+
+#include <cassert>
+#include <cstdio>
+
+namespace SlimFly {
+
+// multiplies two polynomials over GF(_prime) encoded in base '_prime' and
+//  reduces the product by the monic '_modulus' of degree '_power'
+static u32 multiplyPolynomials(u32 _a, u32 _b, u32 _prime, u32 _power,
+                               const std::vector<u32>& _modulus) {
+  std::vector<u32> a(_power);
+  std::vector<u32> b(_power);
+  for (u32 i = 0; i < _power; i++) {
+    a.at(i) = _a % _prime;
+    _a /= _prime;
+    b.at(i) = _b % _prime;
+    _b /= _prime;
+  }
+
+  std::vector<u32> product(2 * _power, 0);
+  for (u32 i = 0; i < _power; i++) {
+    for (u32 j = 0; j < _power; j++) {
+      product.at(i + j) = (product.at(i + j) + a.at(i) * b.at(j)) % _prime;
+    }
+  }
+
+  // subtract multiples of the modulus from the high coefficients down
+  for (u32 d = 2 * _power - 1; d >= _power; d--) {
+    u32 coeff = product.at(d);
+    if (coeff > 0) {
+      for (u32 i = 0; i <= _power; i++) {
+        u32 sub = (coeff * _modulus.at(i)) % _prime;
+        product.at(d - _power + i) =
+            (product.at(d - _power + i) + _prime - sub) % _prime;
+      }
+    }
+  }
+
+  u32 result = 0;
+  for (u32 i = _power; i > 0; i--) {
+    result = result * _prime + product.at(i - 1);
+  }
+  return result;
+}
+
+bool factorPrimePower(u32 _q, u32* _prime, u32* _power) {
+  if (_q < 2) {
+    return false;
+  }
+  u32 prime = 2;
+  while (_q % prime != 0) {
+    prime++;
+  }
+  u32 power = 0;
+  while (_q % prime == 0) {
+    _q /= prime;
+    power++;
+  }
+  *_prime = prime;
+  *_power = power;
+  return _q == 1;
+}
+
+s32 computeDelta(u32 _q) {
+  switch (_q % 4) {
+    case 0:
+      return 0;
+    case 1:
+      return 1;
+    case 3:
+      return -1;
+    default:
+      fprintf(stderr, "Slim Fly needs q = 4w + {-1,0,1}, q=%u\n", _q);
+      assert(false);
+      return 0;
+  }
+}
+
+u32 computeNetworkRadix(u32 _q) {
+  return (3 * _q - computeDelta(_q)) / 2;
+}
+
+void createFiniteField(u32 _q, std::vector<u32>* _add, std::vector<u32>* _mul,
+                       u32* _primitive) {
+  u32 prime, power;
+  if (!factorPrimePower(_q, &prime, &power)) {
+    fprintf(stderr, "Slim Fly needs q to be a prime power, q=%u\n", _q);
+    assert(false);
+  }
+
+  // addition is per coefficient
+  _add->resize(_q * _q);
+  for (u32 a = 0; a < _q; a++) {
+    for (u32 b = 0; b < _q; b++) {
+      u32 sum = 0;
+      u32 scale = 1;
+      for (u32 ta = a, tb = b; scale < _q; ta /= prime, tb /= prime) {
+        sum += (((ta % prime) + (tb % prime)) % prime) * scale;
+        scale *= prime;
+      }
+      _add->at(a * _q + b) = sum;
+    }
+  }
+
+  // try the monic polynomials of degree 'power' until one is irreducible,
+  //  which shows as an element whose powers are all the nonzero elements
+  std::vector<u32> modulus(power + 1);
+  modulus.at(power) = 1;
+  _mul->resize(_q * _q);
+  for (u32 tail = 0; tail < _q; tail++) {
+    for (u32 i = 0, t = tail; i < power; i++, t /= prime) {
+      modulus.at(i) = t % prime;
+    }
+    for (u32 a = 0; a < _q; a++) {
+      for (u32 b = 0; b < _q; b++) {
+        _mul->at(a * _q + b) =
+            multiplyPolynomials(a, b, prime, power, modulus);
+      }
+    }
+
+    for (u32 g = 1; g < _q; g++) {
+      std::vector<bool> seen(_q, false);
+      u32 element = 1;
+      u32 count = 0;
+      while (!seen.at(element)) {
+        seen.at(element) = true;
+        count++;
+        element = _mul->at(element * _q + g);
+      }
+      if ((count == _q - 1) && (element == 1) && !seen.at(0)) {
+        *_primitive = g;
+        return;
+      }
+    }
+  }
+  assert(false);
+}
+
+void computeGeneratorSets(u32 _q, const std::vector<u32>& _mul,
+                          u32 _primitive, std::vector<u32>* _x,
+                          std::vector<u32>* _xp) {
+  // powers of the primitive element
+  std::vector<u32> powers(_q, 1);
+  for (u32 i = 1; i < _q; i++) {
+    powers.at(i) = _mul.at(powers.at(i - 1) * _q + _primitive);
+  }
+
+  _x->clear();
+  _xp->clear();
+  if (computeDelta(_q) == 1) {
+    // X holds the even powers, X' the odd powers
+    for (u32 i = 0; i < _q - 1; i += 2) {
+      _x->push_back(powers.at(i));
+      _xp->push_back(powers.at(i + 1));
+    }
+  } else {
+    // X holds the even powers up to 2w-2 and the odd powers from 2w-1 up to
+    //  4w-3, X' is the same shifted by one
+    u32 w = (_q + 1) / 4;
+    for (u32 i = 0; i < 2 * w - 1; i += 2) {
+      _x->push_back(powers.at(i));
+      _xp->push_back(powers.at(i + 1));
+    }
+    for (u32 i = 2 * w - 1; i < 4 * w - 2; i += 2) {
+      _x->push_back(powers.at(i));
+      _xp->push_back(powers.at(i + 1));
+    }
+  }
+}
+
+u32 computeRouterId(u32 _q, u32 _s, u32 _x, u32 _y) {
+  return (_s * _q + _x) * _q + _y;
+}
+
+void createNeighbors(u32 _q, std::vector<std::vector<u32> >* _neighbors) {
+  std::vector<u32> add;
+  std::vector<u32> mul;
+  u32 primitive;
+  createFiniteField(_q, &add, &mul, &primitive);
+  std::vector<u32> x;
+  std::vector<u32> xp;
+  computeGeneratorSets(_q, mul, primitive, &x, &xp);
+
+  // additive inverses
+  std::vector<u32> negative(_q);
+  for (u32 a = 0; a < _q; a++) {
+    for (u32 b = 0; b < _q; b++) {
+      if (add.at(a * _q + b) == 0) {
+        negative.at(a) = b;
+      }
+    }
+  }
+
+  _neighbors->clear();
+  _neighbors->resize(2 * _q * _q);
+  for (u32 s = 0; s < 2; s++) {
+    const std::vector<u32>& generators = (s == 0) ? x : xp;
+    for (u32 a = 0; a < _q; a++) {
+      for (u32 b = 0; b < _q; b++) {
+        std::vector<u32>& neighbors =
+            _neighbors->at(computeRouterId(_q, s, a, b));
+
+        // (s,a,b) ~ (s,a,b') iff b - b' is in the generator set
+        for (u32 g : generators) {
+          neighbors.push_back(computeRouterId(_q, s, a, add.at(b * _q + g)));
+        }
+
+        // (0,x,y) ~ (1,m,c) iff y = m*x + c
+        for (u32 o = 0; o < _q; o++) {
+          if (s == 0) {
+            u32 c = add.at(b * _q + negative.at(mul.at(o * _q + a)));
+            neighbors.push_back(computeRouterId(_q, 1, o, c));
+          } else {
+            u32 y = add.at(mul.at(a * _q + o) * _q + b);
+            neighbors.push_back(computeRouterId(_q, 0, o, y));
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace SlimFly
@@ -0,0 +1,51 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_SLIMFLY_UTIL_H_
+#define NETWORK_SLIMFLY_UTIL_H_
+
+#include <prim/prim.h>
+
+#include <vector>
+
+namespace SlimFly {
+// finds 'q = prime ^ power', returns false if 'q' is not a prime power
+bool factorPrimePower(u32 _q, u32* _prime, u32* _power);
+
+// the 'delta' of 'q = 4w + delta', in {-1, 0, 1}
+s32 computeDelta(u32 _q);
+
+// the number of router-to-router ports of each router: (3q - delta) / 2
+u32 computeNetworkRadix(u32 _q);
+
+// builds the addition and multiplication tables (q*q, row-major) of GF(q)
+//  and finds a primitive element
+void createFiniteField(u32 _q, std::vector<u32>* _add, std::vector<u32>* _mul,
+                       u32* _primitive);
+
+// the generator sets X and X' of the McKay-Miller-Siran construction
+void computeGeneratorSets(u32 _q, const std::vector<u32>& _mul,
+                          u32 _primitive, std::vector<u32>* _x,
+                          std::vector<u32>* _xp);
+
+// router (s,x,y) has the id (s*q + x)*q + y
+u32 computeRouterId(u32 _q, u32 _s, u32 _x, u32 _y);
+
+// builds the neighbors of each router of the MMS graph. The links of a router
+//  are its intra-subgraph links in generator set order followed by its links
+//  to the other subgraph in order of 'm' for s=0 and of 'x' for s=1.
+void createNeighbors(u32 _q, std::vector<std::vector<u32> >* _neighbors);
+}  // namespace SlimFly
+
+#endif  // NETWORK_SLIMFLY_UTIL_H_
@@ -0,0 +1,102 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/slimfly/util.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "network/graph/RoutingTable.h"
+
+TEST(SlimFly, factorPrimePower) {
+  u32 prime, power;
+  ASSERT_TRUE(SlimFly::factorPrimePower(7, &prime, &power));
+  ASSERT_EQ(7u, prime);
+  ASSERT_EQ(1u, power);
+  ASSERT_TRUE(SlimFly::factorPrimePower(8, &prime, &power));
+  ASSERT_EQ(2u, prime);
+  ASSERT_EQ(3u, power);
+  ASSERT_TRUE(SlimFly::factorPrimePower(9, &prime, &power));
+  ASSERT_EQ(3u, prime);
+  ASSERT_EQ(2u, power);
+  ASSERT_FALSE(SlimFly::factorPrimePower(6, &prime, &power));
+  ASSERT_FALSE(SlimFly::factorPrimePower(12, &prime, &power));
+}
+
+TEST(SlimFly, finiteField) {
+  for (u32 q : {3u, 4u, 5u, 7u, 8u, 9u, 11u, 13u, 16u, 25u, 27u}) {
+    std::vector<u32> add;
+    std::vector<u32> mul;
+    u32 primitive;
+    SlimFly::createFiniteField(q, &add, &mul, &primitive);
+
+    for (u32 a = 0; a < q; a++) {
+      ASSERT_EQ(a, add.at(a * q + 0));
+      ASSERT_EQ(a, mul.at(a * q + 1));
+      ASSERT_EQ(0u, mul.at(a * q + 0));
+      for (u32 b = 0; b < q; b++) {
+        ASSERT_EQ(add.at(a * q + b), add.at(b * q + a));
+        ASSERT_EQ(mul.at(a * q + b), mul.at(b * q + a));
+        for (u32 c = 0; c < q; c++) {
+          // distributive
+          ASSERT_EQ(mul.at(a * q + add.at(b * q + c)),
+                    add.at(mul.at(a * q + b) * q + mul.at(a * q + c)));
+        }
+      }
+    }
+
+    // the powers of the primitive element are all the nonzero elements
+    std::vector<bool> seen(q, false);
+    u32 element = 1;
+    for (u32 i = 0; i < q - 1; i++) {
+      ASSERT_FALSE(seen.at(element));
+      seen.at(element) = true;
+      element = mul.at(element * q + primitive);
+    }
+    ASSERT_EQ(1u, element);
+  }
+}
+
+TEST(SlimFly, diameterAndRadix) {
+  for (u32 q : {3u, 4u, 5u, 7u, 8u, 9u, 11u, 13u}) {
+    std::vector<std::vector<u32> > neighbors;
+    SlimFly::createNeighbors(q, &neighbors);
+    ASSERT_EQ(2 * q * q, neighbors.size());
+
+    s32 delta = SlimFly::computeDelta(q);
+    u32 radix = SlimFly::computeNetworkRadix(q);
+    ASSERT_EQ(static_cast<s32>(2 * radix), static_cast<s32>(3 * q) - delta);
+
+    for (u32 r = 0; r < neighbors.size(); r++) {
+      // every router has the same radix
+      ASSERT_EQ(radix, neighbors.at(r).size());
+
+      // links are bidirectional without self or parallel links
+      std::vector<u32> sorted = neighbors.at(r);
+      std::sort(sorted.begin(), sorted.end());
+      ASSERT_EQ(sorted.end(), std::adjacent_find(sorted.begin(), sorted.end()));
+      for (u32 n : neighbors.at(r)) {
+        ASSERT_NE(r, n);
+        const std::vector<u32>& back = neighbors.at(n);
+        ASSERT_EQ(1, std::count(back.begin(), back.end(), r));
+      }
+    }
+
+    Graph::RoutingTable table(neighbors, 0, 1);
+    ASSERT_EQ(2u, table.diameter());
+  }
+}
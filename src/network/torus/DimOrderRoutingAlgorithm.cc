@@ -151,8 +151,10 @@ void DimOrderRoutingAlgorithm::processRequest(
       vcSet++;
     }
 
-    // add all ports connecting to the destination (based on weight)
-    for (u32 wInd = 0; wInd < dimWeight; wInd++) {
+    // add the ports connecting to the destination (based on weight)
+    u32 links;
+    u32 firstLink = parallelLinks(_flit, dimWeight, &links);
+    for (u32 wInd = firstLink; wInd < firstLink + links; wInd++) {
       addPort(outputPort + wInd, hops, vcSet);
     }
   }
@@ -0,0 +1,210 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "network/torus/MinimalAdaptiveRoutingAlgorithm.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <cassert>
+#include <tuple>
+
+#include "types/Message.h"
+#include "types/Packet.h"
+#include "network/torus/util.h"
+
+namespace Torus {
+
+// the escape VCs are the two dateline VC sets, the rest are adaptive
+static const u32 kEscapeVcs = 2;
+static const u32 kAdaptive = 2;
+
+MinimalAdaptiveRoutingAlgorithm::MinimalAdaptiveRoutingAlgorithm(
+    const std::string& _name, const Component* _parent, Router* _router,
+    u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
+    const std::vector<u32>& _dimensionWidths,
+    const std::vector<u32>& _dimensionWeights, u32 _concentration,
+    Json::Value _settings)
+    : RoutingAlgorithm(_name, _parent, _router, _baseVc, _numVcs, _inputPort,
+                       _inputVc, _dimensionWidths, _dimensionWeights,
+                       _concentration, _settings),
+      mode_(parseRoutingMode(_settings["mode"].asString())) {
+  // two escape VCs and at least one adaptive VC
+  assert(numVcs_ > kEscapeVcs);
+
+  // create the reduction, it only chooses among the adaptive options
+  reduction_ = Reduction::create("Reduction", this, _router, mode_, false,
+                                 _settings["reduction"]);
+}
+
+MinimalAdaptiveRoutingAlgorithm::~MinimalAdaptiveRoutingAlgorithm() {
+  delete reduction_;
+}
+
+void MinimalAdaptiveRoutingAlgorithm::processRequest(
+    Flit* _flit, RoutingAlgorithm::Response* _response) {
+  // ex: [x,y,z]
+  const std::vector<u32>& routerAddress = router_->address();
+  // ex: [c,x,y,z]
+  const std::vector<u32>* destinationAddress =
+      _flit->packet()->message()->getDestinationAddress();
+  assert(routerAddress.size() == (destinationAddress->size() - 1));
+
+  // create a temporary router address with a dummy concentration for use with
+  //  'util.h' 'computeMinimalHops() function'
+  std::vector<u32> tempRA = std::vector<u32>(1 + routerAddress.size());
+  tempRA.at(0) = U32_MAX;  // dummy
+  for (u32 ind = 1; ind < tempRA.size(); ind++) {
+    tempRA.at(ind) = routerAddress.at(ind - 1);
+  }
+
+  //  determine minimum number of hops to destination for reduction algorithm
+  u32 numDimensions = dimensionWidths_.size();
+  u32 hops = computeMinimalHops(&tempRA, destinationAddress, numDimensions,
+                                dimensionWidths_);
+
+  // the VC offset the flit arrived on, below 'kEscapeVcs' is an escape VC
+  u32 inputVcOffset = _flit->getVc() - baseVc_;
+
+  u32 escapeDim = U32_MAX;
+  u32 portBase = concentration_;
+  for (u32 dim = 0; dim < numDimensions; dim++) {
+    u32 dimWeight = dimensionWeights_.at(dim);
+    u32 links;
+    u32 firstLink = parallelLinks(_flit, dimWeight, &links);
+    u32 src = routerAddress.at(dim);
+    u32 dst = destinationAddress->at(dim + 1);
+    if (src != dst) {
+      // a direction is productive if it is a shortest path
+      u32 rightDelta = ((dst > src) ?
+                        (dst - src) :
+                        (dst + dimensionWidths_.at(dim) - src));
+      u32 leftDelta = ((src > dst) ?
+                       (src - dst) :
+                       (src + dimensionWidths_.at(dim) - dst));
+      bool right = rightDelta <= leftDelta;
+      bool left = leftDelta <= rightDelta;
+
+      // adaptive VCs may use every productive direction
+      for (u32 wInd = firstLink; wInd < firstLink + links; wInd++) {
+        if (right) {
+          addPort(portBase + wInd, hops, kAdaptive);
+        }
+        if (left) {
+          addPort(portBase + dimWeight + wInd, hops, kAdaptive);
+        }
+      }
+
+      // escape VCs route in dimension order, randomized tie breaker
+      if (escapeDim == U32_MAX) {
+        escapeDim = dim;
+        bool escapeRight = (right && left) ? gSim->rnd.nextBool() : right;
+
+        // choose output port, figure out next router in this dimension
+        u32 outputPort;
+        bool crossDateline;
+        if (escapeRight) {
+          outputPort = portBase;
+          u32 next = (src + 1) % dimensionWidths_.at(dim);
+          crossDateline = next < src;
+        } else {
+          outputPort = portBase + dimWeight;
+          u32 next = src == 0 ? dimensionWidths_.at(dim) - 1 : src - 1;
+          crossDateline = next > src;
+        }
+
+        // stay in the escape VC set while continuing in the same dimension,
+        //  otherwise start in VC set 0
+        u32 vcSet = 0;
+        if ((inputVcOffset < kEscapeVcs) && (dim == inputPortDim_)) {
+          vcSet = inputVcOffset;
+        }
+
+        // check dateline crossing
+        if (crossDateline) {
+          assert(vcSet == 0);  // only cross once per dim
+          vcSet++;
+        }
+
+        // the escape VC bypasses the reduction so that it is always offered,
+        //  this keeps the escape network reachable and deadlock free
+        for (u32 wInd = firstLink; wInd < firstLink + links; wInd++) {
+          _response->add(outputPort + wInd, baseVc_ + vcSet);
+        }
+      }
+    }
+    portBase += 2 * dimWeight;
+  }
+
+  if (escapeDim == U32_MAX) {
+    // exit - any VC is ok on ejection
+    addPort(destinationAddress->at(0), hops, U32_MAX);
+  }
+
+  // reduction phase
+  const std::unordered_set<std::tuple<u32, u32> >* outputs =
+      reduction_->reduce(nullptr);
+  for (const auto& t : *outputs) {
+    u32 port = std::get<0>(t);
+    if (routingModeIsPort(mode_)) {
+      // port mode
+      u32 vcSet = std::get<1>(t);
+      if (vcSet == U32_MAX) {
+        // exit - all VCs
+        for (u32 vc = baseVc_; vc < baseVc_ + numVcs_; vc++) {
+          _response->add(port, vc);
+        }
+      } else {
+        // adaptive VCs
+        assert(vcSet == kAdaptive);
+        for (u32 vc = baseVc_ + kEscapeVcs; vc < baseVc_ + numVcs_; vc++) {
+          _response->add(port, vc);
+        }
+      }
+    } else {
+      // vc mode
+      u32 vc = std::get<1>(t);
+      _response->add(port, vc);
+    }
+  }
+}
+
+void MinimalAdaptiveRoutingAlgorithm::addPort(u32 _port, u32 _hops,
+                                              u32 _vcSet) {
+  if (routingModeIsPort(mode_)) {
+    // add the port as a whole
+    f64 cong = portCongestion(mode_, router_, inputPort_, inputVc_, _port);
+    reduction_->add(_port, _vcSet, _hops, cong);
+  } else {
+    // add the VCs of the set
+    u32 first, last;
+    if (_vcSet == U32_MAX) {
+      first = baseVc_;
+      last = baseVc_ + numVcs_;
+    } else {
+      assert(_vcSet == kAdaptive);
+      first = baseVc_ + kEscapeVcs;
+      last = baseVc_ + numVcs_;
+    }
+    for (u32 vc = first; vc < last; vc++) {
+      f64 cong = router_->congestionStatus(inputPort_, inputVc_, _port, vc);
+      reduction_->add(_port, vc, _hops, cong);
+    }
+  }
+}
+
+}  // namespace Torus
+
+registerWithObjectFactory("minimal_adaptive", Torus::RoutingAlgorithm,
+                          Torus::MinimalAdaptiveRoutingAlgorithm,
+                          TORUS_ROUTINGALGORITHM_ARGS);
@@ -0,0 +1,63 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NETWORK_TORUS_MINIMALADAPTIVEROUTINGALGORITHM_H_
+#define NETWORK_TORUS_MINIMALADAPTIVEROUTINGALGORITHM_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <vector>
+
+#include "event/Component.h"
+#include "network/torus/RoutingAlgorithm.h"
+#include "router/Router.h"
+#include "routing/mode.h"
+#include "routing/Reduction.h"
+
+namespace Torus {
+
+/*
+ * This is Duato's fully adaptive minimal routing. The first two VCs are the
+ *  escape VCs, they route in dimension order and use the dateline VC sets of
+ *  the dimension order routing algorithm. The other VCs are adaptive, they
+ *  may take any productive direction of any dimension. The reduction chooses
+ *  among the adaptive options using the congestion sensor, the escape VC is
+ *  always offered beside them.
+ */
+class MinimalAdaptiveRoutingAlgorithm : public RoutingAlgorithm {
+ public:
+  MinimalAdaptiveRoutingAlgorithm(
+      const std::string& _name, const Component* _parent, Router* _router,
+      u32 _baseVc, u32 _numVcs, u32 _inputPort, u32 _inputVc,
+      const std::vector<u32>& _dimensionWidths,
+      const std::vector<u32>& _dimensionWeights, u32 _concentration,
+      Json::Value _settings);
+  ~MinimalAdaptiveRoutingAlgorithm();
+
+ protected:
+  void processRequest(
+      Flit* _flit, RoutingAlgorithm::Response* _response) override;
+
+ private:
+  void addPort(u32 _port, u32 _hops, u32 _vcSet);
+
+  const RoutingMode mode_;
+  Reduction* reduction_;
+};
+
+}  // namespace Torus
+
+#endif  // NETWORK_TORUS_MINIMALADAPTIVEROUTINGALGORITHM_H_
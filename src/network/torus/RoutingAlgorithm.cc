@@ -17,6 +17,8 @@
 #include <factory/ObjectFactory.h>
 
 #include "network/torus/util.h"
+#include "types/Message.h"
+#include "types/Packet.h"
 
 namespace Torus {
 
@@ -31,7 +33,10 @@ RoutingAlgorithm::RoutingAlgorithm(
       dimensionWidths_(_dimensionWidths), dimensionWeights_(_dimensionWeights),
       concentration_(_concentration),
       inputPortDim_(computeInputPortDim(dimensionWidths_, dimensionWeights_,
-                                        concentration_, inputPort_)) {}
+                                        concentration_, inputPort_)),
+      deterministic_(_settings["deterministic"].asBool()) {
+  assert(_settings.isMember("deterministic"));
+}
 
 RoutingAlgorithm::~RoutingAlgorithm() {}
 
@@ -59,4 +64,19 @@ RoutingAlgorithm* RoutingAlgorithm::create(
   return ra;
 }
 
+u32 RoutingAlgorithm::parallelLinks(const Flit* _flit, u32 _weight,
+                                    u32* _count) const {
+  if (deterministic_) {
+    // hash the source and destination to find the one link to use
+    u32 sourceId = _flit->packet()->message()->getSourceId();
+    u32 destinationId = _flit->packet()->message()->getDestinationId();
+    *_count = 1;
+    return hasher_(std::make_tuple(sourceId, destinationId)) % _weight;
+  } else {
+    // use all links
+    *_count = _weight;
+    return 0;
+  }
+}
+
 }  // namespace Torus
@@ -15,15 +15,18 @@
 #ifndef NETWORK_TORUS_ROUTINGALGORITHM_H_
 #define NETWORK_TORUS_ROUTINGALGORITHM_H_
 
+#include <colhash/tuplehash.h>
 #include <json/json.h>
 #include <prim/prim.h>
 
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "event/Component.h"
 #include "routing/RoutingAlgorithm.h"
 #include "router/Router.h"
+#include "types/Flit.h"
 
 #define TORUS_ROUTINGALGORITHM_ARGS const std::string&, const Component*, \
     Router*, u32, u32, u32, u32, const std::vector<u32>&, \
@@ -45,10 +48,20 @@ class RoutingAlgorithm : public ::RoutingAlgorithm {
   static RoutingAlgorithm* create(TORUS_ROUTINGALGORITHM_ARGS);
 
  protected:
+  // this returns the first of the '_weight' parallel links to a neighbor that
+  //  the flit may use and sets '_count' to the number of links to use from
+  //  there. deterministic routing pins each source/destination pair to a
+  //  single link.
+  u32 parallelLinks(const Flit* _flit, u32 _weight, u32* _count) const;
+
   const std::vector<u32> dimensionWidths_;
   const std::vector<u32> dimensionWeights_;
   const u32 concentration_;
   const u32 inputPortDim_;
+  const bool deterministic_;
+
+ private:
+  std::hash<std::tuple<u32, u32> > hasher_;
 };
 
 }  // namespace Torus
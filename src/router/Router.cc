@@ -67,3 +67,5 @@ void Router::packetDeparture(u32 _port, Packet* _packet) const {
   _packet->incrementHopCount();
   metadataHandler_->packetRouterDeparture(this, _port, _packet);
 }
+
+void Router::lookaheadRoute(u32 _inputPort, Flit* _flit, u64 _arrivalTime) {}
@@ -30,6 +30,7 @@
 #include "types/FlitReceiver.h"
 #include "types/FlitSender.h"
 
+class Flit;
 class Network;
 
 #define ROUTER_ARGS const std::string&, const Component*, Network*, u32, \
@@ -62,6 +63,12 @@ class Router : public Component, public PortedDevice, public FlitSender,
   virtual f64 congestionStatus(u32 _inputPort, u32 _inputVc,
                                u32 _outputPort, u32 _outputVc) const = 0;
 
+  // this is called by the upstream router when a head flit departs towards
+  //  '_inputPort' of this router and will arrive at '_arrivalTime'. routers
+  //  supporting lookahead routing compute the route the flit will take here
+  //  and store it in the flit.
+  virtual void lookaheadRoute(u32 _inputPort, Flit* _flit, u64 _arrivalTime);
+
  protected:
   Network* network_;
   const std::vector<std::tuple<u32, u32> > protocolClassVcs_;
@@ -27,15 +27,20 @@ Ejector::Ejector(
     : Component(_name, _router),
       router_(_router), portId_(_portId) {
   lastSetTime_ = U32_MAX;
+  setCount_ = 0;
 }
 
 Ejector::~Ejector() {}
 
 void Ejector::receiveFlit(u32 _port, Flit* _flit) {
-  // verify one flit per cycle
+  // verify one flit per cycle per channel lane
   u64 nextTime = gSim->time();
-  assert((lastSetTime_ != nextTime) || (lastSetTime_ == U32_MAX));
-  lastSetTime_ = nextTime;
+  if (lastSetTime_ != nextTime) {
+    lastSetTime_ = nextTime;
+    setCount_ = 0;
+  }
+  setCount_++;
+  assert(setCount_ <= router_->getOutputChannel(portId_)->width());
 
   // send flit using the router
   router_->sendFlit(portId_, _flit);
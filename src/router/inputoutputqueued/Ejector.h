@@ -39,6 +39,7 @@ class Ejector : public Component, public FlitReceiver {
   Router* router_;
   u32 portId_;
   u64 lastSetTime_;
+  u32 setCount_;
 };
 
 }  // namespace InputOutputQueued
@@ -31,19 +31,21 @@ namespace InputOutputQueued {
 InputQueue::InputQueue(
     const std::string& _name, const Component* _parent, Router* _router,
     u32 _depth, u32 _port, u32 _numVcs, u32 _vc, bool _vcaSwaWait,
-    RoutingAlgorithm* _routingAlgorithm, VcScheduler* _vcScheduler,
-    u32 _vcSchedulerIndex, CrossbarScheduler* _crossbarScheduler,
-    u32 _crossbarSchedulerIndex, Crossbar* _crossbar, u32 _crossbarIndex,
-    CreditWatcher* _creditWatcher, bool _decrCreditWatcher)
+    bool _vcReallocation, RoutingAlgorithm* _routingAlgorithm,
+    VcScheduler* _vcScheduler, u32 _vcSchedulerIndex,
+    CrossbarScheduler* _crossbarScheduler, u32 _crossbarSchedulerIndex,
+    Crossbar* _crossbar, u32 _crossbarIndex, CreditWatcher* _creditWatcher,
+    bool _decrCreditWatcher)
     : Component(_name, _parent), depth_(0), port_(_port), numVcs_(_numVcs),
-      vc_(_vc), vcaSwaWait_(_vcaSwaWait), router_(_router),
+      vc_(_vc), vcaSwaWait_(_vcaSwaWait), vcReallocation_(_vcReallocation),
+      router_(_router),
       routingAlgorithm_(_routingAlgorithm), vcScheduler_(_vcScheduler),
       vcSchedulerIndex_(_vcSchedulerIndex),
       crossbarScheduler_(_crossbarScheduler),
       crossbarSchedulerIndex_(_crossbarSchedulerIndex),
       crossbar_(_crossbar), crossbarIndex_(_crossbarIndex),
       creditWatcher_(_creditWatcher), decrCreditWatcher_(_decrCreditWatcher),
-      lastReceivedTime_(U64_MAX) {
+      lastReceivedTime_(U64_MAX), receivedCount_(0) {
   // ensure the buffer is empty
   assert(buffer_.size() == 0);
 
@@ -85,10 +87,15 @@ void InputQueue::receiveFlit(u32 _port, Flit* _flit) {
   // make sure this is the right VC
   assert(_flit->getVc() == vc_);
 
-  // we can only receive one flit per cycle
+  // we can only receive as many flits per cycle as the channel is wide
   assert((lastReceivedTime_ == U64_MAX) ||
-         (lastReceivedTime_ < gSim->time()));
-  lastReceivedTime_ = gSim->time();
+         (lastReceivedTime_ <= gSim->time()));
+  if (lastReceivedTime_ != gSim->time()) {
+    lastReceivedTime_ = gSim->time();
+    receivedCount_ = 0;
+  }
+  receivedCount_++;
+  assert(receivedCount_ <= router_->getInputChannel(port_)->width());
 
   // push flit into corresponding buffer
   buffer_.push(_flit);
@@ -136,16 +143,7 @@ void InputQueue::vcSchedulerResponse(u32 _vcIdx) {
 
   if (_vcIdx != U32_MAX) {
     // granted
-    vca_.fsm = ePipelineFsm::kReadyToAdvance;
-    vca_.allocatedVcIdx = _vcIdx;
-    router_->vcIndexInv(_vcIdx, &vca_.allocatedPort, &vca_.allocatedVc);
-    routingAlgorithm_->vcScheduled(vca_.flit, vca_.allocatedPort,
-                                   vca_.allocatedVc);
-
-    // log traffic
-    router_->network()->logTraffic(
-        router_, port_, vc_, vca_.allocatedPort, vca_.allocatedVc,
-        vca_.flit->packet()->numFlits());
+    vcAllocated(_vcIdx);
   } else {
     // denied
     vca_.fsm = ePipelineFsm::kWaitingToRequest;
@@ -155,6 +153,48 @@ void InputQueue::vcSchedulerResponse(u32 _vcIdx) {
   setPipelineEvent();
 }
 
+void InputQueue::vcAllocated(u32 _vcIdx) {
+  vca_.fsm = ePipelineFsm::kReadyToAdvance;
+  vca_.allocatedVcIdx = _vcIdx;
+  router_->vcIndexInv(_vcIdx, &vca_.allocatedPort, &vca_.allocatedVc);
+  routingAlgorithm_->vcScheduled(vca_.flit, vca_.allocatedPort,
+                                 vca_.allocatedVc);
+
+  // log traffic
+  router_->network()->logTraffic(
+      router_, port_, vc_, vca_.allocatedPort, vca_.allocatedVc,
+      vca_.flit->packet()->numFlits());
+}
+
+bool InputQueue::reallocateVc(u32 _vcIdx) {
+  // the next head flit must be waiting to request VC allocation
+  if (vca_.fsm != ePipelineFsm::kWaitingToRequest) {
+    return false;
+  }
+  assert(vca_.flit->isHead());
+
+  // other clients waiting for the VC get a chance to allocate it
+  if (vcScheduler_->contended(_vcIdx, vcSchedulerIndex_)) {
+    return false;
+  }
+
+  // the VC scheduler would mask the VC if it lacks buffer space
+  if (!vcScheduler_->eligible(_vcIdx)) {
+    return false;
+  }
+
+  // the released VC must be one of its route options
+  for (u32 r = 0; r < vca_.route.size(); r++) {
+    u32 port, vc;
+    vca_.route.get(r, &port, &vc);
+    if (router_->vcIndex(port, vc) == _vcIdx) {
+      vcAllocated(_vcIdx);
+      return true;
+    }
+  }
+  return false;
+}
+
 void InputQueue::crossbarSchedulerResponse(u32 _port, u32 _vcIdx) {
   assert(swa_.fsm == ePipelineFsm::kWaitingForResponse);
 
@@ -194,11 +234,13 @@ void InputQueue::processPipeline() {
       creditWatcher_->decrementCredit(swa_.allocatedVcIdx);
     }
 
-    // if this is a tail flit, release the VC
-    /** NOTE: this causes a stall when there are back-to-back
-        packets in the same VC going to the same VC **/
+    // if this is a tail flit, release the VC unless it is passed directly to
+    //  the next packet (this avoids a stall between back-to-back packets in
+    //  the same VC going to the same VC)
     if (swa_.flit->isTail()) {
-      vcScheduler_->releaseVc(swa_.allocatedVcIdx);
+      if (!vcReallocation_ || !reallocateVc(swa_.allocatedVcIdx)) {
+        vcScheduler_->releaseVc(swa_.allocatedVcIdx);
+      }
     }
 
     // clear SWA info
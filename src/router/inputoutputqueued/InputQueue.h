@@ -41,7 +41,8 @@ class InputQueue : public Component, public FlitReceiver,
  public:
   InputQueue(const std::string& _name, const Component* _parent,
              Router* _router, u32 _depth, u32 _port, u32 _numVcs, u32 _vc,
-             bool _vcaSwaWait, RoutingAlgorithm* _routingAlgorithm,
+             bool _vcaSwaWait, bool _vcReallocation,
+             RoutingAlgorithm* _routingAlgorithm,
              VcScheduler* _vcScheduler, u32 _vcSchedulerIndex,
              CrossbarScheduler* _crossbarScheduler, u32 _crossbarSchedulerIndex,
              Crossbar* _crossbar, u32 _crossbarIndex,
@@ -68,6 +69,8 @@ class InputQueue : public Component, public FlitReceiver,
  private:
   void setPipelineEvent();
   void processPipeline();
+  void vcAllocated(u32 _vcIdx);
+  bool reallocateVc(u32 _vcIdx);
 
   // attributes
   u32 depth_;
@@ -77,6 +80,7 @@ class InputQueue : public Component, public FlitReceiver,
 
   // settings
   const bool vcaSwaWait_;  // stall VCA until SWA is empty
+  const bool vcReallocation_;  // a tail passes its VC to the next head
 
   // external devices
   Router* router_;
@@ -90,8 +94,9 @@ class InputQueue : public Component, public FlitReceiver,
   CreditWatcher* creditWatcher_;
   const bool decrCreditWatcher_;
 
-  // single flit per clock input limit assurance
+  // flits per clock input limit assurance
   u64 lastReceivedTime_;
+  u32 receivedCount_;
 
   // state machine to represent a generic pipeline stage
   enum class ePipelineFsm { kEmpty, kWaitingToRequest, kWaitingForResponse,
@@ -94,6 +94,7 @@ class OutputQueue : public Component, public FlitReceiver,
   struct {
     ePipelineFsm fsm;
     Flit* flit;
+    u32 flits;  // granted flits, the following ones of the packet too
   } swa_;
 
   // Crossbar traversal [xtr_] stage (no state needed)
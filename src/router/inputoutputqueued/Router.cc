@@ -19,6 +19,8 @@
 #include <cassert>
 #include <cmath>
 
+#include <algorithm>
+
 #include "architecture/util.h"
 #include "congestion/CongestionSensor.h"
 #include "network/Network.h"
@@ -71,10 +73,27 @@ Router::Router(
     assert(false);
   }
 
+  // shared input queues
+  assert(_settings.isMember("input_queue_damq") &&
+         _settings["input_queue_damq"].isBool());
+  inputQueueDamq_ = _settings["input_queue_damq"].asBool();
+  inputQueueReserved_ = 0;
+  if (inputQueueDamq_) {
+    assert(_settings.isMember("input_queue_reserved") &&
+           _settings["input_queue_reserved"].isUInt());
+    inputQueueReserved_ = _settings["input_queue_reserved"].asUInt();
+    assert(inputQueueReserved_ > 0);
+  }
+  portOccupancy_.resize(numPorts_, 0);
+  portCapacity_.resize(numPorts_, 0);
+
   // pipeline control
   assert(_settings.isMember("vca_swa_wait") &&
          _settings["vca_swa_wait"].isBool());
   bool vcaSwaWait = _settings["vca_swa_wait"].asBool();
+  assert(_settings.isMember("vc_reallocation") &&
+         _settings["vc_reallocation"].isBool());
+  bool vcReallocation = _settings["vc_reallocation"].asBool();
 
   // create a congestion status device
   congestionSensor_ = CongestionSensor::create(
@@ -92,6 +111,16 @@ Router::Router(
       numPorts_ * numVcs_, 0, Simulator::Clock::ROUTER,
       _settings["crossbar_scheduler"]);
 
+  // crossbar speedup, the number of flits an input port may send and an output
+  //  port may receive per cycle (0 means one per VC)
+  assert(_settings.isMember("input_speedup") &&
+         _settings["input_speedup"].isUInt());
+  assert(_settings.isMember("output_speedup") &&
+         _settings["output_speedup"].isUInt());
+  crossbarScheduler_->setSpeedup(
+      numVcs_, _settings["input_speedup"].asUInt(),
+      numVcs_, _settings["output_speedup"].asUInt());
+
   // determine the credit updates the input queue will need to provide
   bool iqDecrWatcher =
       ((congestionMode_ == Router::CongestionMode::kOutput) ||
@@ -122,8 +151,9 @@ Router::Router(
       std::string iqName = "InputQueue" + nameSuffix;
       InputQueue* iq = new InputQueue(
           iqName, this, this, inputQueueDepth_, port, numVcs_, vc, vcaSwaWait,
-          rf, vcScheduler_, clientIndex, crossbarScheduler_, clientIndex,
-          crossbar_, clientIndex, congestionSensor_, iqDecrWatcher);
+          vcReallocation, rf, vcScheduler_, clientIndex, crossbarScheduler_,
+          clientIndex, crossbar_, clientIndex, congestionSensor_,
+          iqDecrWatcher);
       inputQueues_.at(vcIdx) = iq;
 
       // register the input queue with VC and crossbar schedulers
@@ -149,6 +179,11 @@ Router::Router(
         outputCrossbarSchedulerName, this, numVcs_, numVcs_, 1, port * numVcs_,
         Simulator::Clock::CHANNEL, _settings["output_crossbar_scheduler"]);
 
+    // the output port switch allocator holds the downstream credit counts,
+    //  the VC scheduler masks by these rather than the output queue space
+    vcScheduler_->setCreditSource(outputCrossbarSchedulers_.at(port),
+                                  port * numVcs_);
+
     // output crossbar
     std::string outputCrossbarName = "OutputCrossbar_" + std::to_string(port);
     outputCrossbars_.at(port) = new Crossbar(
@@ -247,6 +282,15 @@ void Router::initialize() {
         queueDepth = 0;
       }
     }
+
+    // a DAMQ input queue may hold its reserved space and all space the other
+    //  VCs don't reserve, the port holds as much as with private queues
+    portCapacity_.at(port) = queueDepth * numVcs_;
+    if (inputQueueDamq_) {
+      u32 reserved = std::min(inputQueueReserved_, queueDepth);
+      queueDepth = reserved + ((queueDepth - reserved) * numVcs_);
+    }
+
     for (u32 vc = 0; vc < numVcs_; vc++) {
       // set depth
       u32 vcIdx = vcIndex(port, vc);
@@ -254,6 +298,15 @@ void Router::initialize() {
     }
   }
 
+  // wide output channels accept more than one flit per cycle
+  for (u32 port = 0; port < numPorts_; port++) {
+    if (outputChannels_.at(port)) {
+      u32 width = outputChannels_.at(port)->width();
+      outputCrossbarSchedulers_.at(port)->setPortWidth(0, width);
+      outputCrossbars_.at(port)->setWidth(width);
+    }
+  }
+
   // init credits
   for (u32 port = 0; port < numPorts_; port++) {
     // donwstream queue depth
@@ -269,6 +322,16 @@ void Router::initialize() {
       }
     }
 
+    // the credits of a DAMQ downstream queue are shared by the VCs
+    u32 reserved = credits;
+    u32 shared = 0;
+    bool damq = inputQueueDamq_ && (credits != U32_MAX);
+    if (damq) {
+      reserved = std::min(inputQueueReserved_, credits);
+      shared = (credits - reserved) * numVcs_;
+      credits = reserved + shared;
+    }
+
     for (u32 vc = 0; vc < numVcs_; vc++) {
       u32 vcIdx = vcIndex(port, vc);
       // initialize the credit count in the CrossbarScheduler
@@ -296,6 +359,10 @@ void Router::initialize() {
         congestionSensor_->initCredits(vcIdx, 1);
       }
     }
+    if (damq) {
+      outputCrossbarSchedulers_.at(port)->initSharedCredits(
+          0, numVcs_, reserved, shared);
+    }
   }
 }
 
@@ -304,6 +371,12 @@ void Router::receiveFlit(u32 _port, Flit* _flit) {
   InputQueue* iq = inputQueues_.at(vcIndex(_port, vc));
   iq->receiveFlit(0, _flit);
 
+  // the VCs of a DAMQ input queue can't overflow the port's buffer space
+  if (inputQueueDamq_) {
+    portOccupancy_.at(_port)++;
+    assert(portOccupancy_.at(_port) <= portCapacity_.at(_port));
+  }
+
   // inform base class of arrival
   if (_flit->isHead()) {
     packetArrival(_port, _flit->packet());
@@ -339,10 +412,16 @@ void Router::sendCredit(u32 _port, u32 _vc) {
 
   // mark the credit with the specified VC
   credit->putNum(_vc);
+
+  // the flit left the input queue
+  if (inputQueueDamq_) {
+    assert(portOccupancy_.at(_port) > 0);
+    portOccupancy_.at(_port)--;
+  }
 }
 
 void Router::sendFlit(u32 _port, Flit* _flit) {
-  assert(outputChannels_.at(_port)->getNextFlit() == nullptr);
+  assert(!outputChannels_.at(_port)->isNextFlitSlotFull());
   outputChannels_.at(_port)->setNextFlit(_flit);
 
   // inform base class of departure
@@ -82,6 +82,11 @@ class Router : public ::Router {
   f64 inputQueueMult_;
   u32 inputQueueMax_;
   u32 inputQueueMin_;
+  // DAMQ input queues, the VCs of a port share the port's buffer space
+  bool inputQueueDamq_;
+  u32 inputQueueReserved_;
+  std::vector<u32> portOccupancy_;
+  std::vector<u32> portCapacity_;
 
   std::vector<InputQueue*> inputQueues_;
   std::vector<RoutingAlgorithm*> routingAlgorithms_;
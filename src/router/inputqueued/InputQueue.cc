@@ -31,18 +31,23 @@ namespace InputQueued {
 InputQueue::InputQueue(
     const std::string& _name, const Component* _parent, Router* _router,
     u32 _depth, u32 _port, u32 _numVcs, u32 _vc, bool _vcaSwaWait,
-    RoutingAlgorithm* _routingAlgorithm, VcScheduler* _vcScheduler,
-    u32 _vcSchedulerIndex, CrossbarScheduler* _crossbarScheduler,
-    u32 _crossbarSchedulerIndex, Crossbar* _crossbar, u32 _crossbarIndex,
-    CreditWatcher* _creditWatcher)
+    bool _speculativeSwa, bool _lookaheadRouting, bool _pipelineBypass,
+    bool _vcReallocation, RoutingAlgorithm* _routingAlgorithm,
+    VcScheduler* _vcScheduler, u32 _vcSchedulerIndex,
+    CrossbarScheduler* _crossbarScheduler, u32 _crossbarSchedulerIndex,
+    Crossbar* _crossbar, u32 _crossbarIndex, CreditWatcher* _creditWatcher)
     : Component(_name, _parent), depth_(0), port_(_port), numVcs_(_numVcs),
-      vc_(_vc), vcaSwaWait_(_vcaSwaWait), router_(_router),
+      vc_(_vc), vcaSwaWait_(_vcaSwaWait), speculativeSwa_(_speculativeSwa),
+      lookaheadRouting_(_lookaheadRouting), pipelineBypass_(_pipelineBypass),
+      vcReallocation_(_vcReallocation),
+      router_(_router),
       routingAlgorithm_(_routingAlgorithm), vcScheduler_(_vcScheduler),
       vcSchedulerIndex_(_vcSchedulerIndex),
       crossbarScheduler_(_crossbarScheduler),
       crossbarSchedulerIndex_(_crossbarSchedulerIndex),
       crossbar_(_crossbar), crossbarIndex_(_crossbarIndex),
-      creditWatcher_(_creditWatcher), lastReceivedTime_(U64_MAX) {
+      creditWatcher_(_creditWatcher), lastReceivedTime_(U64_MAX),
+      receivedCount_(0) {
   // ensure the buffer is empty
   assert(buffer_.size() == 0);
 
@@ -64,6 +69,8 @@ InputQueue::InputQueue(
   swa_.flit = nullptr;
   swa_.allocatedPort = U32_MAX;
   swa_.allocatedVcIdx = U32_MAX;
+  swa_.speculative = false;
+  swa_.flits = 0;
 
   // no event is set to trigger
   eventTime_ = U64_MAX;
@@ -84,10 +91,15 @@ void InputQueue::receiveFlit(u32 _port, Flit* _flit) {
   // make sure this is the right VC
   assert(_flit->getVc() == vc_);
 
-  // we can only receive one flit per cycle
+  // we can only receive as many flits per cycle as the channel is wide
   assert((lastReceivedTime_ == U64_MAX) ||
-         (lastReceivedTime_ < gSim->time()));
-  lastReceivedTime_ = gSim->time();
+         (lastReceivedTime_ <= gSim->time()));
+  if (lastReceivedTime_ != gSim->time()) {
+    lastReceivedTime_ = gSim->time();
+    receivedCount_ = 0;
+  }
+  receivedCount_++;
+  assert(receivedCount_ <= router_->getInputChannel(port_)->width());
 
   // push flit into corresponding buffer
   buffer_.push(_flit);
@@ -135,16 +147,7 @@ void InputQueue::vcSchedulerResponse(u32 _vcIdx) {
 
   if (_vcIdx != U32_MAX) {
     // granted
-    vca_.fsm = ePipelineFsm::kReadyToAdvance;
-    vca_.allocatedVcIdx = _vcIdx;
-    router_->vcIndexInv(_vcIdx, &vca_.allocatedPort, &vca_.allocatedVc);
-    routingAlgorithm_->vcScheduled(vca_.flit, vca_.allocatedPort,
-                                   vca_.allocatedVc);
-
-    // log traffic
-    router_->network()->logTraffic(
-        router_, port_, vc_, vca_.allocatedPort, vca_.allocatedVc,
-        vca_.flit->packet()->numFlits());
+    vcAllocated(_vcIdx);
   } else {
     // denied
     vca_.fsm = ePipelineFsm::kWaitingToRequest;
@@ -154,12 +157,55 @@ void InputQueue::vcSchedulerResponse(u32 _vcIdx) {
   setPipelineEvent();
 }
 
+void InputQueue::vcAllocated(u32 _vcIdx) {
+  vca_.fsm = ePipelineFsm::kReadyToAdvance;
+  vca_.allocatedVcIdx = _vcIdx;
+  router_->vcIndexInv(_vcIdx, &vca_.allocatedPort, &vca_.allocatedVc);
+  routingAlgorithm_->vcScheduled(vca_.flit, vca_.allocatedPort,
+                                 vca_.allocatedVc);
+
+  // log traffic
+  router_->network()->logTraffic(
+      router_, port_, vc_, vca_.allocatedPort, vca_.allocatedVc,
+      vca_.flit->packet()->numFlits());
+}
+
+bool InputQueue::reallocateVc(u32 _vcIdx) {
+  // the next head flit must be waiting to request VC allocation
+  if (vca_.fsm != ePipelineFsm::kWaitingToRequest) {
+    return false;
+  }
+  assert(vca_.flit->isHead());
+
+  // other clients waiting for the VC get a chance to allocate it
+  if (vcScheduler_->contended(_vcIdx, vcSchedulerIndex_)) {
+    return false;
+  }
+
+  // the VC scheduler would mask the VC if it lacks buffer space
+  if (!vcScheduler_->eligible(_vcIdx)) {
+    return false;
+  }
+
+  // the released VC must be one of its route options
+  for (u32 r = 0; r < vca_.route.size(); r++) {
+    u32 port, vc;
+    vca_.route.get(r, &port, &vc);
+    if (router_->vcIndex(port, vc) == _vcIdx) {
+      vcAllocated(_vcIdx);
+      return true;
+    }
+  }
+  return false;
+}
+
 void InputQueue::crossbarSchedulerResponse(u32 _port, u32 _vcIdx) {
   assert(swa_.fsm == ePipelineFsm::kWaitingForResponse);
 
   if (_port != U32_MAX) {
     // granted
     swa_.fsm = ePipelineFsm::kReadyToAdvance;
+    swa_.flits = crossbarScheduler_->grantedFlits(crossbarSchedulerIndex_);
   } else {
     // denied
     swa_.fsm = ePipelineFsm::kWaitingToRequest;
@@ -180,22 +226,41 @@ void InputQueue::processPipeline() {
   // make sure the pipeline is being processed on clock cycle boundaries
   assert(gSim->time() % gSim->cycleTime(Simulator::Clock::ROUTER) == 0);
 
+  /*
+   * resolve a speculative switch allocation
+   */
+  if (swa_.speculative) {
+    resolveSpeculation();
+  }
+
   /*
    * attempt to load the crossbar
    */
   if (swa_.fsm == ePipelineFsm::kReadyToAdvance) {
     // dbgprintf("loading crossbar");
 
-    // send the flit on the crossbar, consume a credit
-    crossbar_->inject(swa_.flit, crossbarIndex_, swa_.allocatedPort);
-    crossbarScheduler_->decrementCredit(swa_.allocatedVcIdx);
-    creditWatcher_->decrementCredit(swa_.allocatedVcIdx);
-
-    // if this is a tail flit, release the VC
-    /** NOTE: this causes a stall when there are back-to-back
-        packets in the same VC going to the same VC **/
-    if (swa_.flit->isTail()) {
-      vcScheduler_->releaseVc(swa_.allocatedVcIdx);
+    // send the flits on the crossbar, consume a credit for each, on a wide
+    //  port the following flits of the packet may go along
+    assert(swa_.flits > 0);
+    for (u32 f = 0; f < swa_.flits; f++) {
+      Flit* flit = swa_.flit;
+      if (f > 0) {
+        flit = takeNextPacketFlit();
+        flit->setVc(swa_.flit->getVc());
+      }
+      crossbar_->inject(flit, crossbarIndex_, swa_.allocatedPort);
+      crossbarScheduler_->decrementCredit(swa_.allocatedVcIdx);
+      creditWatcher_->decrementCredit(swa_.allocatedVcIdx);
+
+      // if this is a tail flit, release the VC unless it is passed directly
+      //  to the next packet (this avoids a stall between back-to-back packets
+      //  in the same VC going to the same VC)
+      if (flit->isTail()) {
+        assert(f == swa_.flits - 1);
+        if (!vcReallocation_ || !reallocateVc(swa_.allocatedVcIdx)) {
+          vcScheduler_->releaseVc(swa_.allocatedVcIdx);
+        }
+      }
     }
 
     // clear SWA info
@@ -203,6 +268,7 @@ void InputQueue::processPipeline() {
     swa_.flit = nullptr;
     swa_.allocatedPort = U32_MAX;
     swa_.allocatedVcIdx = U32_MAX;
+    swa_.flits = 0;
   }
 
   /*
@@ -237,13 +303,47 @@ void InputQueue::processPipeline() {
     }
   }
 
+  /*
+   * bypass, a body flit arriving at an idle pipeline already has its VC and
+   *  goes straight to SWA
+   */
+  if ((pipelineBypass_) && (buffer_.size() == 1) &&
+      (rfe_.fsm == ePipelineFsm::kEmpty) &&
+      (vca_.fsm == ePipelineFsm::kEmpty) &&
+      (swa_.fsm == ePipelineFsm::kEmpty) &&
+      (!buffer_.front()->isHead())) {
+    // dbgprintf("bypassing to SWA");
+    assert(swa_.flit == nullptr);
+    assert(vca_.allocatedVcIdx != U32_MAX);
+
+    // pull out the flit and send a credit back
+    Flit* flit = buffer_.front();
+    buffer_.pop();
+    router_->sendCredit(port_, vc_);
+
+    // set SWA info
+    swa_.flit = flit;
+    swa_.flit->setVc(vca_.allocatedVc);
+    swa_.allocatedPort = vca_.allocatedPort;
+    swa_.allocatedVcIdx = vca_.allocatedVcIdx;
+    swa_.fsm = ePipelineFsm::kWaitingToRequest;
+    if (swa_.flit->isTail()) {
+      vca_.allocatedVcIdx = U32_MAX;
+      vca_.allocatedPort = U32_MAX;
+      vca_.allocatedVc = U32_MAX;
+    }
+  }
+
   /*
    * Attempt to submit a SWA request
    */
   if (swa_.fsm == ePipelineFsm::kWaitingToRequest) {
+    // a wide output channel can take the queued flits of the packet too, the
+    //  scheduler limits the grant to the channel width
+    u32 flits = 1 + queuedPacketFlits();
     crossbarScheduler_->request(
         crossbarSchedulerIndex_, swa_.allocatedPort, swa_.allocatedVcIdx,
-        swa_.flit);
+        swa_.flit, flits);
     swa_.fsm = ePipelineFsm::kWaitingForResponse;
   }
 
@@ -285,6 +385,32 @@ void InputQueue::processPipeline() {
     rfe_.route.clear();
   }
 
+  /*
+   * with lookahead routing, flits skip the RFE stage when it is empty
+   */
+  if ((lookaheadRouting_) && (vca_.fsm == ePipelineFsm::kEmpty) &&
+      (rfe_.fsm == ePipelineFsm::kEmpty) && (buffer_.empty() == false) &&
+      (!buffer_.front()->isHead() || buffer_.front()->hasLookahead())) {
+    // dbgprintf("loading VCA from buffer");
+    assert(vca_.flit == nullptr);
+
+    // pull out the front flit and send a credit back
+    Flit* flit = buffer_.front();
+    buffer_.pop();
+    router_->sendCredit(port_, vc_);
+
+    // set VCA info
+    vca_.flit = flit;
+    if (flit->isHead()) {
+      assert(vca_.allocatedVcIdx == U32_MAX);
+      useLookahead(flit, &vca_.route);
+      vca_.fsm = ePipelineFsm::kWaitingToRequest;
+    } else {
+      assert(vca_.allocatedVcIdx != U32_MAX);
+      vca_.fsm = ePipelineFsm::kReadyToAdvance;
+    }
+  }
+
   /*
    * attempt to submit VCA requests
    */
@@ -305,6 +431,23 @@ void InputQueue::processPipeline() {
       u32 vcIdx = router_->vcIndex(requestPort, requestVc);
       vcScheduler_->request(vcSchedulerIndex_, vcIdx, metadata);
     }
+
+    // speculatively request the switch for the first route option, when
+    //  bypassing this is done whenever nothing is queued behind the flit
+    if ((speculativeSwa_ || (pipelineBypass_ && buffer_.empty())) &&
+        (swa_.fsm == ePipelineFsm::kEmpty)) {
+      assert(swa_.flit == nullptr);
+      u32 requestPort, requestVc;
+      vca_.route.get(0, &requestPort, &requestVc);
+      swa_.flit = vca_.flit;
+      swa_.allocatedPort = requestPort;
+      swa_.allocatedVcIdx = router_->vcIndex(requestPort, requestVc);
+      swa_.speculative = true;
+      crossbarScheduler_->speculativeRequest(
+          crossbarSchedulerIndex_, swa_.allocatedPort, swa_.allocatedVcIdx,
+          swa_.flit);
+      swa_.fsm = ePipelineFsm::kWaitingForResponse;
+    }
   }
 
   /*
@@ -335,8 +478,14 @@ void InputQueue::processPipeline() {
    * attempt to submit a routing request
    */
   if (rfe_.fsm == ePipelineFsm::kWaitingToRequest) {
-    // if this is a head flit, submit a routing request
-    if (rfe_.flit->isHead()) {
+    // if this is a head flit, submit a routing request unless the upstream
+    //  router already computed the route
+    if ((rfe_.flit->isHead()) && (lookaheadRouting_) &&
+        (rfe_.flit->hasLookahead())) {
+      // dbgprintf("[RFE], head flit, lookahead");
+      useLookahead(rfe_.flit, &rfe_.route);
+      rfe_.fsm = ePipelineFsm::kReadyToAdvance;
+    } else if (rfe_.flit->isHead()) {
       // dbgprintf("[RFE], head flit");
 
       // submit request
@@ -370,4 +519,100 @@ void InputQueue::processPipeline() {
   }
 }
 
+void InputQueue::useLookahead(Flit* _flit,
+                              RoutingAlgorithm::Response* _route) {
+  assert(_flit->hasLookahead());
+  _route->clear();
+  for (const auto& option : _flit->getLookahead()) {
+    _route->add(option.first, option.second);
+  }
+  _flit->clearLookahead();
+}
+
+u32 InputQueue::queuedPacketFlits() const {
+  // the flits of the SWA flit's packet that are queued behind it
+  u32 remaining = swa_.flit->packet()->numFlits() - swa_.flit->id() - 1;
+  u32 queued = buffer_.size();
+  if (vca_.flit != nullptr) {
+    queued++;
+  }
+  if (rfe_.flit != nullptr) {
+    queued++;
+  }
+  return std::min(remaining, queued);
+}
+
+Flit* InputQueue::takeNextPacketFlit() {
+  // take the next flit from the earliest non-empty stage
+  Flit* flit;
+  if (vca_.flit != nullptr) {
+    assert(vca_.fsm == ePipelineFsm::kReadyToAdvance);
+    flit = vca_.flit;
+    vca_.fsm = ePipelineFsm::kEmpty;
+    vca_.flit = nullptr;
+    vca_.route.clear();
+  } else if (rfe_.flit != nullptr) {
+    assert(rfe_.fsm == ePipelineFsm::kReadyToAdvance);
+    flit = rfe_.flit;
+    rfe_.fsm = ePipelineFsm::kEmpty;
+    rfe_.flit = nullptr;
+    rfe_.route.clear();
+  } else {
+    flit = buffer_.front();
+    buffer_.pop();
+    router_->sendCredit(port_, vc_);
+  }
+  assert(!flit->isHead());
+
+  // clear the allocated info on the tail flit
+  if (flit->isTail()) {
+    vca_.allocatedVcIdx = U32_MAX;
+    vca_.allocatedPort = U32_MAX;
+    vca_.allocatedVc = U32_MAX;
+  }
+  return flit;
+}
+
+void InputQueue::resolveSpeculation() {
+  // both allocators respond in the same cycle
+  assert(swa_.fsm != ePipelineFsm::kWaitingForResponse);
+  assert(vca_.fsm != ePipelineFsm::kWaitingForResponse);
+  assert(swa_.flit == vca_.flit);
+
+  // the speculation succeeded if the switch was granted on the port of the
+  //  allocated VC and that VC can accept the flit
+  bool success = ((swa_.fsm == ePipelineFsm::kReadyToAdvance) &&
+                  (vca_.fsm == ePipelineFsm::kReadyToAdvance) &&
+                  (vca_.allocatedPort == swa_.allocatedPort) &&
+                  (crossbarScheduler_->sufficientCredits(
+                      vca_.allocatedVcIdx, swa_.flit)));
+
+  if (success) {
+    // move the flit out of VCA as if SWA had been loaded normally
+    swa_.flit->setVc(vca_.allocatedVc);
+    swa_.allocatedVcIdx = vca_.allocatedVcIdx;
+    swa_.speculative = false;
+
+    vca_.fsm = ePipelineFsm::kEmpty;
+    vca_.flit = nullptr;
+    vca_.route.clear();
+    if (swa_.flit->isTail()) {
+      vca_.allocatedVcIdx = U32_MAX;
+      vca_.allocatedPort = U32_MAX;
+      vca_.allocatedVc = U32_MAX;
+    }
+  } else {
+    // misspeculation, discard the switch grant (if any)
+    if (swa_.fsm == ePipelineFsm::kReadyToAdvance) {
+      crossbarScheduler_->releaseLock(crossbarSchedulerIndex_,
+                                      swa_.allocatedPort);
+    }
+    swa_.fsm = ePipelineFsm::kEmpty;
+    swa_.flit = nullptr;
+    swa_.allocatedPort = U32_MAX;
+    swa_.allocatedVcIdx = U32_MAX;
+    swa_.speculative = false;
+  }
+}
+
 }  // namespace InputQueued
@@ -41,7 +41,9 @@ class InputQueue : public Component, public FlitReceiver,
  public:
   InputQueue(const std::string& _name, const Component* _parent,
              Router* _router, u32 _depth, u32 _port, u32 _numVcs, u32 _vc,
-             bool _vcaSwaWait, RoutingAlgorithm* _routingAlgorithm,
+             bool _vcaSwaWait, bool _speculativeSwa, bool _lookaheadRouting,
+             bool _pipelineBypass, bool _vcReallocation,
+             RoutingAlgorithm* _routingAlgorithm,
              VcScheduler* _vcScheduler, u32 _vcSchedulerIndex,
              CrossbarScheduler* _crossbarScheduler, u32 _crossbarSchedulerIndex,
              Crossbar* _crossbar, u32 _crossbarIndex,
@@ -69,6 +71,12 @@ class InputQueue : public Component, public FlitReceiver,
  private:
   void setPipelineEvent();
   void processPipeline();
+  void resolveSpeculation();
+  u32 queuedPacketFlits() const;
+  Flit* takeNextPacketFlit();
+  void useLookahead(Flit* _flit, RoutingAlgorithm::Response* _route);
+  void vcAllocated(u32 _vcIdx);
+  bool reallocateVc(u32 _vcIdx);
 
   // attributes
   u32 depth_;
@@ -78,6 +86,10 @@ class InputQueue : public Component, public FlitReceiver,
 
   // settings
   const bool vcaSwaWait_;  // stall VCA until SWA is empty
+  const bool speculativeSwa_;  // request SWA in parallel with VCA
+  const bool lookaheadRouting_;  // routes are computed by the upstream router
+  const bool pipelineBypass_;  // flits skip the stages of an idle pipeline
+  const bool vcReallocation_;  // a tail passes its VC to the next head
 
   // external devices
   Router* router_;
@@ -90,8 +102,9 @@ class InputQueue : public Component, public FlitReceiver,
   const u32 crossbarIndex_;
   CreditWatcher* creditWatcher_;
 
-  // single flit per clock input limit assurance
+  // flits per clock input limit assurance
   u64 lastReceivedTime_;
+  u32 receivedCount_;
 
   // state machine to represent a generic pipeline stage
   enum class ePipelineFsm { kEmpty, kWaitingToRequest, kWaitingForResponse,
@@ -125,11 +138,15 @@ class InputQueue : public Component, public FlitReceiver,
   } vca_;
 
   // Switch allocation [swa_] pipeline stage
+  //  a speculative entry shares its head flit with the VCA stage and is
+  //  resolved once both allocators have responded
   struct {
     ePipelineFsm fsm;
     Flit* flit;
     u32 allocatedPort;
     u32 allocatedVcIdx;
+    bool speculative;
+    u32 flits;  // granted flits, the following ones of the packet too
   } swa_;
 
   // Crossbar traversal [xtr_] stage (no state needed)
@@ -32,9 +32,10 @@ OutputQueue::OutputQueue(
     const std::string& _name, const Component* _parent, Router* _router,
     u32 _depth, u32 _port, CreditWatcher* _creditWatcher,
     bool _incrCreditWatcher)
-    : Component(_name, _parent), depth_(_depth), port_(_port), router_(_router),
-      creditWatcher_(_creditWatcher), incrCreditWatcher_(_incrCreditWatcher),
-      lastReceivedTime_(U64_MAX) {
+    : Component(_name, _parent), depth_(_depth), port_(_port), width_(1),
+      router_(_router), creditWatcher_(_creditWatcher),
+      incrCreditWatcher_(_incrCreditWatcher), lastReceivedTime_(U64_MAX),
+      receivedCount_(0) {
   // ensure the buffer is empty
   assert(buffer_.size() == 0);
 
@@ -44,16 +45,26 @@ OutputQueue::OutputQueue(
 
 OutputQueue::~OutputQueue() {}
 
+void OutputQueue::setWidth(u32 _width) {
+  assert(_width > 0);
+  width_ = _width;
+}
+
 void OutputQueue::receiveFlit(u32 _port, Flit* _flit) {
   assert(gSim->epsilon() == 1);
 
   // 'port' is unused
   assert(_port == 0);
 
-  // we can only receive one flit per cycle
+  // we can only receive 'width_' flits per cycle
   assert((lastReceivedTime_ == U64_MAX) ||
-         (lastReceivedTime_ < gSim->time()));
-  lastReceivedTime_ = gSim->time();
+         (lastReceivedTime_ <= gSim->time()));
+  if (lastReceivedTime_ != gSim->time()) {
+    lastReceivedTime_ = gSim->time();
+    receivedCount_ = 0;
+  }
+  receivedCount_++;
+  assert(receivedCount_ <= width_);
 
   // push flit into corresponding buffer
   buffer_.push(_flit);
@@ -83,14 +94,16 @@ void OutputQueue::processPipeline() {
   assert(gSim->time() % gSim->cycleTime(Simulator::Clock::CHANNEL) == 0);
 
   /*
-   * Send the next flit on the output channel
+   * Send the next flits on the output channel
    */
-  Flit* flit = buffer_.front();
-  buffer_.pop();
-  router_->sendFlit(port_, flit);
-  if (incrCreditWatcher_) {
-    u32 vcIdx = router_->vcIndex(port_, flit->getVc());
-    creditWatcher_->incrementCredit(vcIdx);
+  for (u32 f = 0; (f < width_) && (buffer_.size() > 0); f++) {
+    Flit* flit = buffer_.front();
+    buffer_.pop();
+    router_->sendFlit(port_, flit);
+    if (incrCreditWatcher_) {
+      u32 vcIdx = router_->vcIndex(port_, flit->getVc());
+      creditWatcher_->incrementCredit(vcIdx);
+    }
   }
 
   // clear the eventTime_ variable to indicate no more events are set
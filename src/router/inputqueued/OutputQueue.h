@@ -37,6 +37,9 @@ class OutputQueue : public Component, public FlitReceiver {
               CreditWatcher* _creditWatcher, bool _incrCreditWatcher);
   ~OutputQueue();
 
+  // sets the flits per cycle of the output channel
+  void setWidth(u32 _width);
+
   // called by main router crossbar
   void receiveFlit(u32 _port, Flit* _flit) override;
 
@@ -49,14 +52,16 @@ class OutputQueue : public Component, public FlitReceiver {
   // attributes
   const u32 depth_;
   const u32 port_;
+  u32 width_;
 
   // external components
   Router* router_;
   CreditWatcher* creditWatcher_;
   const bool incrCreditWatcher_;
 
-  // single flit per clock input limit assurance
+  // 'width_' flits per clock input limit assurance
   u64 lastReceivedTime_;
+  u32 receivedCount_;
 
   // state machine to represent a generic pipeline stage
   enum class ePipelineFsm { kEmpty, kWaitingToRequest, kWaitingForResponse,
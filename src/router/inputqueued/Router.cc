@@ -18,6 +18,8 @@
 
 #include <cassert>
 
+#include <algorithm>
+
 #include "architecture/util.h"
 #include "congestion/CongestionSensor.h"
 #include "network/Network.h"
@@ -67,10 +69,36 @@ Router::Router(
     assert(false);
   }
 
+  // shared input queues
+  assert(_settings.isMember("input_queue_damq") &&
+         _settings["input_queue_damq"].isBool());
+  inputQueueDamq_ = _settings["input_queue_damq"].asBool();
+  inputQueueReserved_ = 0;
+  if (inputQueueDamq_) {
+    assert(_settings.isMember("input_queue_reserved") &&
+           _settings["input_queue_reserved"].isUInt());
+    inputQueueReserved_ = _settings["input_queue_reserved"].asUInt();
+    assert(inputQueueReserved_ > 0);
+  }
+  portOccupancy_.resize(numPorts_, 0);
+  portCapacity_.resize(numPorts_, 0);
+
   // pipeline control
   assert(_settings.isMember("vca_swa_wait") &&
          _settings["vca_swa_wait"].isBool());
   bool vcaSwaWait = _settings["vca_swa_wait"].asBool();
+  assert(_settings.isMember("speculative_swa") &&
+         _settings["speculative_swa"].isBool());
+  bool speculativeSwa = _settings["speculative_swa"].asBool();
+  assert(_settings.isMember("lookahead_routing") &&
+         _settings["lookahead_routing"].isBool());
+  lookaheadRouting_ = _settings["lookahead_routing"].asBool();
+  assert(_settings.isMember("pipeline_bypass") &&
+         _settings["pipeline_bypass"].isBool());
+  bool pipelineBypass = _settings["pipeline_bypass"].asBool();
+  assert(_settings.isMember("vc_reallocation") &&
+         _settings["vc_reallocation"].isBool());
+  bool vcReallocation = _settings["vc_reallocation"].asBool();
   u32 outputQueueDepth = _settings["output_queue_depth"].asUInt();
   assert(outputQueueDepth > 0);
 
@@ -97,6 +125,7 @@ Router::Router(
   crossbarScheduler_ = new CrossbarScheduler(
       "CrossbarScheduler", this, numPorts_ * numVcs_, numPorts_ * numVcs_,
       numPorts_, 0, Simulator::Clock::ROUTER, _settings["crossbar_scheduler"]);
+  vcScheduler_->setCreditSource(crossbarScheduler_, 0);
 
   // create routing algorithms, input queues, link to routing algorithm,
   //  crossbar, and schedulers
@@ -115,6 +144,11 @@ Router::Router(
       RoutingAlgorithm* rf = network_->createRoutingAlgorithm(
           port, vc, rfname, this, this);
       routingAlgorithms_.at(vcIdx) = rf;
+      if (lookaheadRouting_ && !rf->supportsLookahead()) {
+        fprintf(stderr, "The routing algorithm doesn't support lookahead "
+                "routing\n");
+        assert(false);
+      }
 
       // compute the client index (same for VC alloc, SW alloc, and Xbar)
       u32 clientIndex = (port * numVcs_) + vc;
@@ -123,6 +157,7 @@ Router::Router(
       std::string iqName = "InputQueue" + nameSuffix;
       InputQueue* iq = new InputQueue(
           iqName, this, this, inputQueueDepth_, port, numVcs_, vc, vcaSwaWait,
+          speculativeSwa, lookaheadRouting_, pipelineBypass, vcReallocation,
           rf, vcScheduler_, clientIndex, crossbarScheduler_, clientIndex,
           crossbar_, clientIndex, congestionSensor_);
       inputQueues_.at(vcIdx) = iq;
@@ -205,6 +240,15 @@ void Router::initialize() {
         queueDepth = 0;
       }
     }
+
+    // a DAMQ input queue may hold its reserved space and all space the other
+    //  VCs don't reserve, the port holds as much as with private queues
+    portCapacity_.at(port) = queueDepth * numVcs_;
+    if (inputQueueDamq_) {
+      u32 reserved = std::min(inputQueueReserved_, queueDepth);
+      queueDepth = reserved + ((queueDepth - reserved) * numVcs_);
+    }
+
     for (u32 vc = 0; vc < numVcs_; vc++) {
       // set depth
       u32 vcIdx = vcIndex(port, vc);
@@ -212,6 +256,21 @@ void Router::initialize() {
     }
   }
 
+  // wide output channels accept more than one flit per cycle
+  u32 maxWidth = 1;
+  for (u32 port = 0; port < numPorts_; port++) {
+    if (outputChannels_.at(port)) {
+      u32 width = outputChannels_.at(port)->width();
+      crossbarScheduler_->setPortWidth(port, width);
+      outputQueues_.at(port)->setWidth(width);
+      maxWidth = std::max(maxWidth, width);
+    }
+  }
+  crossbar_->setWidth(maxWidth);
+
+  // a VC may send as many flits per cycle as the widest output channel takes
+  creditSize_ *= maxWidth;
+
   // init credits
   for (u32 port = 0; port < numPorts_; port++) {
     // donwstream queue depth
@@ -227,6 +286,16 @@ void Router::initialize() {
       }
     }
 
+    // the credits of a DAMQ downstream queue are shared by the VCs
+    u32 reserved = credits;
+    u32 shared = 0;
+    bool damq = inputQueueDamq_ && (credits != U32_MAX);
+    if (damq) {
+      reserved = std::min(inputQueueReserved_, credits);
+      shared = (credits - reserved) * numVcs_;
+      credits = reserved + shared;
+    }
+
     for (u32 vc = 0; vc < numVcs_; vc++) {
       u32 vcIdx = vcIndex(port, vc);
       // initialize the credit count in the CrossbarScheduler
@@ -236,6 +305,10 @@ void Router::initialize() {
       //  queues
       congestionSensor_->initCredits(vcIdx, credits);
     }
+    if (damq) {
+      crossbarScheduler_->initSharedCredits(vcIndex(port, 0), numVcs_,
+                                            reserved, shared);
+    }
   }
 }
 
@@ -244,6 +317,12 @@ void Router::receiveFlit(u32 _port, Flit* _flit) {
   InputQueue* iq = inputQueues_.at(vcIndex(_port, vc));
   iq->receiveFlit(0, _flit);
 
+  // the VCs of a DAMQ input queue can't overflow the port's buffer space
+  if (inputQueueDamq_) {
+    portOccupancy_.at(_port)++;
+    assert(portOccupancy_.at(_port) <= portCapacity_.at(_port));
+  }
+
   // inform base class of arrival
   if (_flit->isHead()) {
     packetArrival(_port, _flit->packet());
@@ -273,15 +352,32 @@ void Router::sendCredit(u32 _port, u32 _vc) {
 
   // mark the credit with the specified VC
   credit->putNum(_vc);
+
+  // the flit left the input queue
+  if (inputQueueDamq_) {
+    assert(portOccupancy_.at(_port) > 0);
+    portOccupancy_.at(_port)--;
+  }
 }
 
 void Router::sendFlit(u32 _port, Flit* _flit) {
-  assert(outputChannels_.at(_port)->getNextFlit() == nullptr);
-  outputChannels_.at(_port)->setNextFlit(_flit);
+  assert(!outputChannels_.at(_port)->isNextFlitSlotFull());
+  u64 injectTime = outputChannels_.at(_port)->setNextFlit(_flit);
 
   // inform base class of departure
   if (_flit->isHead()) {
     packetDeparture(_port, _flit->packet());
+
+    // have the next router compute its route while the flit is in flight
+    if (lookaheadRouting_) {
+      Channel* channel = outputChannels_.at(_port);
+      ::Router* next = dynamic_cast<::Router*>(channel->getSink());
+      if (next != nullptr) {
+        u64 arrivalTime = injectTime + (channel->latency() *
+            gSim->cycleTime(Simulator::Clock::CHANNEL));
+        next->lookaheadRoute(channel->getSinkPort(), _flit, arrivalTime);
+      }
+    }
   }
 }
 
@@ -291,6 +387,46 @@ f64 Router::congestionStatus(u32 _inputPort, u32 _inputVc,
                                    _outputVc);
 }
 
+void Router::lookaheadRoute(u32 _inputPort, Flit* _flit, u64 _arrivalTime) {
+  assert(_flit->isHead());
+  _flit->clearLookahead();
+  if (!lookaheadRouting_) {
+    return;
+  }
+
+  // routing algorithms run at the beginning of a router cycle, if that can't
+  //  happen before the flit arrives it is routed normally
+  u64 computeTime = gSim->futureCycle(Simulator::Clock::ROUTER, 1);
+  if (computeTime <= _arrivalTime) {
+    LookaheadEvent* evt = new LookaheadEvent();
+    evt->inputPort = _inputPort;
+    evt->flit = _flit;
+    addEvent(computeTime, 0, evt, 0);
+  }
+}
+
+void Router::processEvent(void* _event, s32 _type) {
+  LookaheadEvent* evt = reinterpret_cast<LookaheadEvent*>(_event);
+  Flit* flit = evt->flit;
+  u32 inputPort = evt->inputPort;
+  delete evt;
+
+  // run the routing algorithm of the input VC the flit will arrive on
+  RoutingAlgorithm* rf = routingAlgorithms_.at(
+      vcIndex(inputPort, flit->getVc()));
+  lookaheadResponse_.link(rf);
+  lookaheadResponse_.clear();
+  rf->lookahead(flit, &lookaheadResponse_);
+  assert(lookaheadResponse_.size() > 0);
+
+  // carry the response in the flit
+  for (u32 r = 0; r < lookaheadResponse_.size(); r++) {
+    u32 port, vc;
+    lookaheadResponse_.get(r, &port, &vc);
+    flit->addLookahead(port, vc);
+  }
+}
+
 Router::CongestionMode Router::parseCongestionMode(const std::string& _mode) {
   if (_mode == "output") {
     return Router::CongestionMode::kOutput;
@@ -66,6 +66,9 @@ class Router : public ::Router {
   f64 congestionStatus(u32 _inputPort, u32 _inputVc, u32 _outputPort,
                        u32 _outputVc) const override;
 
+  void lookaheadRoute(u32 _inputPort, Flit* _flit, u64 _arrivalTime) override;
+  void processEvent(void* _event, s32 _type) override;
+
  private:
   enum class CongestionMode {kOutput, kDownstream};
 
@@ -79,6 +82,19 @@ class Router : public ::Router {
   f64 inputQueueMult_;
   u32 inputQueueMax_;
   u32 inputQueueMin_;
+  // DAMQ input queues, the VCs of a port share the port's buffer space
+  bool inputQueueDamq_;
+  u32 inputQueueReserved_;
+  std::vector<u32> portOccupancy_;
+  std::vector<u32> portCapacity_;
+
+  // lookahead routing
+  struct LookaheadEvent {
+    u32 inputPort;
+    Flit* flit;
+  };
+  bool lookaheadRouting_;
+  RoutingAlgorithm::Response lookaheadResponse_;
 
   std::vector<InputQueue*> inputQueues_;
   std::vector<RoutingAlgorithm*> routingAlgorithms_;
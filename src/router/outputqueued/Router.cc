@@ -226,6 +226,19 @@ Channel* Router::getOutputChannel(u32 _port) const {
 }
 
 void Router::initialize() {
+  // packets are transferred to the output queues as soon as the head arrives
+  //  which relies on each input port delivering one packet at a time, the
+  //  lanes of a wide channel would interleave packets
+  for (u32 port = 0; port < numPorts_; port++) {
+    if ((inputChannels_.at(port) && (inputChannels_.at(port)->width() > 1)) ||
+        (outputChannels_.at(port) &&
+         (outputChannels_.at(port)->width() > 1))) {
+      fprintf(stderr, "the output-queued router requires channels with a "
+              "width of 1\n");
+      assert(false);
+    }
+  }
+
   // set input queue depth
   for (u32 port = 0; port < numPorts_; port++) {
     u32 queueDepth = inputQueueDepth_;
@@ -377,8 +390,13 @@ void Router::registerPacket(u32 _inputPort, u32 _inputVc, Flit* _headFlit,
   u32 outputVcIdx = vcIndex(_outputPort, _outputVc);
 
   // put the packet in the waiting list for this
-  waiting_.at(outputVcIdx).push(
-      std::make_tuple(_inputPort, _inputVc, _headFlit, _outputPort, _outputVc));
+  WaitingPacket waiting;
+  waiting.inputPort = _inputPort;
+  waiting.inputVc = _inputVc;
+  waiting.headFlit = _headFlit;
+  waiting.outputPort = _outputPort;
+  waiting.outputVc = _outputVc;
+  waiting_[outputVcIdx].push(waiting);
 
   // execute the processor on epsilon 2
   addEvent(gSim->time(), 2, nullptr, static_cast<s32>(outputVcIdx));
@@ -413,19 +431,19 @@ void Router::processEvent(void* _event, s32 _type) {
 void Router::processTransfers(u32 _outputVcIdx) {
   assert(gSim->epsilon() == 2);
 
+  RingBuffer<WaitingPacket>& waiting = waiting_[_outputVcIdx];
   while (true) {
     // see if there is any waiting packets
-    if (waiting_.at(_outputVcIdx).empty()) {
+    if (waiting.empty()) {
       // nothing to do, just be done
       break;
     }
 
     // get the next waiting packet
-    const std::tuple<u32, u32, Flit*, u32, u32> next =
-        waiting_.at(_outputVcIdx).front();
+    const WaitingPacket& next = waiting.front();
 
     // determine if it can fit in the output queue
-    Flit* headFlit = std::get<2>(next);
+    Flit* headFlit = next.headFlit;
     Packet* packet = headFlit->packet();
     u32 pktSize = packet->numFlits();
     u32 space = outputQueues_.at(_outputVcIdx)->spaceAvailable();
@@ -437,7 +455,7 @@ void Router::processTransfers(u32 _outputVcIdx) {
       outputQueues_.at(_outputVcIdx)->reserveSpace(pktSize);
 
       // change VCs and decrement congestion status credits if needed
-      u32 outputVc = std::get<4>(next);
+      u32 outputVc = next.outputVc;
       for (u32 f = 0; f < pktSize; f++) {
         // change VCs
         Flit* flit = packet->getFlit(f);
@@ -456,11 +474,11 @@ void Router::processTransfers(u32 _outputVcIdx) {
       addEvent(time, 1, packet, static_cast<s32>(_outputVcIdx));
 
       // inform the input queue
-      u32 inputVcIdx = vcIndex(std::get<0>(next), std::get<1>(next));
+      u32 inputVcIdx = vcIndex(next.inputPort, next.inputVc);
       inputQueues_.at(inputVcIdx)->pullPacket(headFlit);
 
       // pop the packet out of the waiting list
-      waiting_.at(_outputVcIdx).pop();
+      waiting.pop();
     } else {
       break;
     }
@@ -18,7 +18,6 @@
 #include <json/json.h>
 #include <prim/prim.h>
 
-#include <queue>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -33,6 +32,7 @@
 #include "router/Router.h"
 #include "types/Credit.h"
 #include "types/Flit.h"
+#include "util/RingBuffer.h"
 
 class Network;
 
@@ -80,6 +80,15 @@ class Router : public ::Router {
  private:
   enum class CongestionMode {kOutput, kDownstream, kOutputAndDownstream};
 
+  // a packet registered by an input queue awaiting output queue space
+  struct WaitingPacket {
+    u32 inputPort;
+    u32 inputVc;
+    Flit* headFlit;
+    u32 outputPort;
+    u32 outputVc;
+  };
+
   static CongestionMode parseCongestionMode(const std::string& _mode);
 
   // executes on epsilon 2
@@ -123,7 +132,7 @@ class Router : public ::Router {
   std::vector<Channel*> outputChannels_;
 
   // this is used to solve any starvation issues
-  std::vector<std::queue<std::tuple<u32, u32, Flit*, u32, u32> > > waiting_;
+  std::vector<RingBuffer<WaitingPacket> > waiting_;
 };
 
 }  // namespace OutputQueued
@@ -0,0 +1,144 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "router/packetlevel/InputQueue.h"
+
+#include <cassert>
+
+#include "network/Network.h"
+#include "router/packetlevel/OutputPort.h"
+#include "router/packetlevel/Router.h"
+
+namespace PacketLevel {
+
+InputQueue::InputQueue(
+    const std::string& _name, const Component* _parent, Router* _router,
+    u32 _port, u32 _vc, RoutingAlgorithm* _routingAlgorithm)
+    : Component(_name, _parent), router_(_router), port_(_port), vc_(_vc),
+      routingAlgorithm_(_routingAlgorithm), depth_(0), occupancy_(0),
+      frontArrived_(0), frontDeparted_(0), backArrived_(0), routing_(false),
+      server_(nullptr) {
+  route_.clear();
+  route_.link(routingAlgorithm_);
+}
+
+InputQueue::~InputQueue() {}
+
+void InputQueue::setDepth(u32 _depth) {
+  depth_ = _depth;
+}
+
+void InputQueue::receiveFlit(Flit* _flit) {
+  assert(gSim->epsilon() == 1);
+
+  // buffer the flit
+  occupancy_++;
+  assert(occupancy_ <= depth_);  // overflow check
+
+  // a head flit starts a new packet at the back of the queue
+  Packet* packet = _flit->packet();
+  if (_flit->isHead()) {
+    packets_.push(packet);
+    backArrived_ = 0;
+  }
+  backArrived_++;
+
+  // track the front packet, route it when it just became the front
+  if (packet == packets_.front()) {
+    frontArrived_++;
+    if (_flit->isHead()) {
+      route();
+    } else if (server_ != nullptr) {
+      server_->flitArrived();
+    }
+  }
+}
+
+void InputQueue::routingAlgorithmResponse(
+    RoutingAlgorithm::Response* _response) {
+  assert(gSim->epsilon() == 0);
+  assert(routing_);
+  routing_ = false;
+
+  // retrieve the routing algorithm outputs, randomly select one
+  u32 routeIndex = gSim->rnd.nextU64(0, route_.size() - 1);
+  u32 outputPort, outputVc;
+  route_.get(routeIndex, &outputPort, &outputVc);
+
+  // inform the routing algorithm of vc scheduled
+  Packet* packet = packets_.front();
+  Flit* headFlit = packet->getFlit(0);
+  routingAlgorithm_->vcScheduled(headFlit, outputPort, outputVc);
+
+  // log traffic
+  router_->network()->logTraffic(
+      router_, port_, vc_, outputPort, outputVc, packet->numFlits());
+
+  // wait for the output port to serve the packet
+  router_->requestOutput(this, packet, outputPort, outputVc);
+}
+
+void InputQueue::setServer(OutputPort* _outputPort) {
+  assert(server_ == nullptr);
+  server_ = _outputPort;
+}
+
+u32 InputQueue::arrivedFlits() const {
+  return frontArrived_;
+}
+
+void InputQueue::flitDeparted() {
+  assert(server_ != nullptr);
+  assert(frontDeparted_ < frontArrived_);
+
+  // the flit left the buffer
+  frontDeparted_++;
+  assert(occupancy_ > 0);
+  occupancy_--;
+
+  // when the tail leaves, give the packet's credits back upstream and advance
+  //  to the next packet
+  Packet* packet = packets_.front();
+  if (frontDeparted_ == packet->numFlits()) {
+    router_->sendCredits(port_, vc_, packet->numFlits());
+    packets_.pop();
+    server_ = nullptr;
+    frontDeparted_ = 0;
+    frontArrived_ = 0;
+    if (!packets_.empty()) {
+      // packets behind the back one have fully arrived
+      frontArrived_ = (packets_.size() == 1) ?
+          backArrived_ : packets_.front()->numFlits();
+      route();
+    }
+  }
+}
+
+u32 InputQueue::port() const {
+  return port_;
+}
+
+u32 InputQueue::vc() const {
+  return vc_;
+}
+
+void InputQueue::route() {
+  assert(!routing_);
+  assert(server_ == nullptr);
+  routing_ = true;
+  route_.clear();
+  routingAlgorithm_->request(this, packets_.front()->getFlit(0), &route_);
+}
+
+}  // namespace PacketLevel
@@ -0,0 +1,81 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROUTER_PACKETLEVEL_INPUTQUEUE_H_
+#define ROUTER_PACKETLEVEL_INPUTQUEUE_H_
+
+#include <prim/prim.h>
+
+#include <string>
+
+#include "event/Component.h"
+#include "routing/RoutingAlgorithm.h"
+#include "types/Flit.h"
+#include "types/Packet.h"
+#include "util/RingBuffer.h"
+
+namespace PacketLevel {
+
+class OutputPort;
+class Router;
+
+class InputQueue : public Component, public RoutingAlgorithm::Client {
+ public:
+  InputQueue(const std::string& _name, const Component* _parent,
+             Router* _router, u32 _port, u32 _vc,
+             RoutingAlgorithm* _routingAlgorithm);
+  ~InputQueue();
+
+  // set input queue depth (tailor mode)
+  void setDepth(u32 _depth);
+
+  // called by the router when a flit arrives (epsilon 1)
+  void receiveFlit(Flit* _flit);
+
+  // response from the routing algorithm (epsilon 0)
+  void routingAlgorithmResponse(RoutingAlgorithm::Response* _response) override;
+
+  // called by the output port serving the front packet
+  void setServer(OutputPort* _outputPort);
+  u32 arrivedFlits() const;
+  void flitDeparted();
+
+  u32 port() const;
+  u32 vc() const;
+
+ private:
+  // submits a routing request for the front packet
+  void route();
+
+  Router* router_;
+  const u32 port_;
+  const u32 vc_;
+  RoutingAlgorithm* routingAlgorithm_;
+  RoutingAlgorithm::Response route_;
+
+  u32 depth_;
+  u32 occupancy_;
+
+  // the packets held in this queue, the front one is being routed or served
+  RingBuffer<Packet*> packets_;
+  u32 frontArrived_;  // flits of the front packet that arrived
+  u32 frontDeparted_;  // flits of the front packet that departed
+  u32 backArrived_;  // flits of the back packet that arrived
+  bool routing_;
+  OutputPort* server_;  // non-null while the front packet is being served
+};
+
+}  // namespace PacketLevel
+
+#endif  // ROUTER_PACKETLEVEL_INPUTQUEUE_H_
@@ -0,0 +1,197 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "router/packetlevel/OutputPort.h"
+
+#include <cassert>
+#include <cmath>
+
+#include <algorithm>
+
+#include "router/packetlevel/InputQueue.h"
+#include "router/packetlevel/Router.h"
+
+namespace PacketLevel {
+
+OutputPort::OutputPort(
+    const std::string& _name, const Component* _parent, Router* _router,
+    u32 _port, u32 _numVcs, u32 _latency, f64 _bandwidth,
+    CreditWatcher* _creditWatcher, u32 _creditWatcherBase)
+    : Component(_name, _parent), router_(_router), port_(_port),
+      numVcs_(_numVcs), latency_(_latency), bandwidth_(_bandwidth), width_(1),
+      interval_(1.0 / _bandwidth),
+      creditWatcher_(_creditWatcher), creditWatcherBase_(_creditWatcherBase) {
+  assert(latency_ > 0);
+  assert((_bandwidth > 0.0) && (_bandwidth <= 1.0));
+
+  credits_.resize(numVcs_, 0);
+  maxCredits_.resize(numVcs_, 0);
+
+  busy_ = false;
+  stalled_ = false;
+  nextFlit_ = 0;
+  nextDeparture_ = 0.0;
+  eventTime_ = U64_MAX;
+}
+
+OutputPort::~OutputPort() {}
+
+void OutputPort::setWidth(u32 _width) {
+  assert(_width > 0);
+  width_ = _width;
+  interval_ = 1.0 / (bandwidth_ * width_);
+}
+
+void OutputPort::initCredits(u32 _vc, u32 _credits) {
+  credits_.at(_vc) = _credits;
+  maxCredits_.at(_vc) = _credits;
+  creditWatcher_->initCredits(creditWatcherBase_ + _vc, _credits);
+}
+
+void OutputPort::incrementCredits(u32 _vc, u32 _credits) {
+  assert(gSim->epsilon() > 0);
+  credits_.at(_vc) += _credits;
+  assert(credits_.at(_vc) <= maxCredits_.at(_vc));
+  creditWatcher_->incrementCredits(creditWatcherBase_ + _vc, _credits);
+
+  // a waiting packet might be able to start now
+  if (!busy_ && !requests_.empty()) {
+    setEvent(gSim->time());
+  }
+}
+
+void OutputPort::request(InputQueue* _inputQueue, Packet* _packet, u32 _vc) {
+  assert(gSim->epsilon() == 0);
+
+  // the whole packet must fit in the downstream buffer
+  assert(_packet->numFlits() <= maxCredits_.at(_vc));
+
+  // the packet can't start before the router latency passed, aligned to the
+  //  channel clock which this port transmits on
+  u64 readyTime = gSim->futureCycle(Simulator::Clock::ROUTER, latency_);
+  u64 cycleTime = gSim->cycleTime(Simulator::Clock::CHANNEL);
+  readyTime = ((readyTime + cycleTime - 1) / cycleTime) * cycleTime;
+
+  Request request;
+  request.inputQueue = _inputQueue;
+  request.packet = _packet;
+  request.vc = _vc;
+  request.readyTime = readyTime;
+  requests_.push_back(request);
+  setEvent(readyTime);
+}
+
+void OutputPort::flitArrived() {
+  if (stalled_) {
+    stalled_ = false;
+    setEvent(gSim->time());
+  }
+}
+
+void OutputPort::processEvent(void* _event, s32 _type) {
+  assert(gSim->epsilon() == 2);
+
+  // an earlier event already took care of this one
+  if (gSim->time() != eventTime_) {
+    return;
+  }
+  eventTime_ = U64_MAX;
+  process();
+}
+
+void OutputPort::setEvent(u64 _time) {
+  if (_time < eventTime_) {
+    eventTime_ = _time;
+    addEvent(eventTime_, 2, nullptr, 0);
+  }
+}
+
+void OutputPort::process() {
+  assert(gSim->isCycle(Simulator::Clock::CHANNEL));
+  u64 now = gSim->time();
+  u64 cycle = gSim->cycle(Simulator::Clock::CHANNEL);
+
+  while (true) {
+    // when idle, start the oldest ready packet with credits for all its flits
+    if (!busy_) {
+      for (auto it = requests_.begin(); it != requests_.end(); ++it) {
+        u32 numFlits = it->packet->numFlits();
+        if ((it->readyTime <= now) && (credits_.at(it->vc) >= numFlits)) {
+          current_ = *it;
+          requests_.erase(it);
+          credits_.at(current_.vc) -= numFlits;
+          creditWatcher_->decrementCredits(creditWatcherBase_ + current_.vc,
+                                           numFlits);
+          current_.inputQueue->setServer(this);
+          busy_ = true;
+          nextFlit_ = 0;
+          break;
+        }
+      }
+    }
+
+    // transmit the next flits while the channel has slots this cycle and the
+    //  flits have arrived
+    bool finished = false;
+    while (busy_ && (departureCycle() <= cycle)) {
+      if (current_.inputQueue->arrivedFlits() > nextFlit_) {
+        Flit* flit = current_.packet->getFlit(nextFlit_);
+        flit->setVc(current_.vc);
+        router_->sendFlit(port_, flit);
+        current_.inputQueue->flitDeparted();
+        nextFlit_++;
+        nextDeparture_ = std::max(nextDeparture_, (f64)cycle) + interval_;
+        if (nextFlit_ == current_.packet->numFlits()) {
+          busy_ = false;
+          finished = true;
+        }
+      } else {
+        // the input queue will tell when the flit arrives
+        stalled_ = true;
+        break;
+      }
+    }
+
+    // a finished packet lets the next one start
+    if (!finished) {
+      break;
+    }
+  }
+
+  // determine when this port needs to run again
+  if (busy_) {
+    if (!stalled_) {
+      u64 departure = std::max(cycle + 1, departureCycle());
+      setEvent(departure * gSim->cycleTime(Simulator::Clock::CHANNEL));
+    }
+  } else {
+    // credit arrivals wake the port for requests that are ready
+    u64 next = U64_MAX;
+    for (const Request& request : requests_) {
+      if (request.readyTime > now) {
+        next = std::min(next, request.readyTime);
+      }
+    }
+    if (next != U64_MAX) {
+      setEvent(next);
+    }
+  }
+}
+
+u64 OutputPort::departureCycle() const {
+  u64 slot = (u64)std::ceil((nextDeparture_ * width_) - 1e-9);
+  return slot / width_;
+}
+
+}  // namespace PacketLevel
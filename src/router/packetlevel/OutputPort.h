@@ -0,0 +1,104 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROUTER_PACKETLEVEL_OUTPUTPORT_H_
+#define ROUTER_PACKETLEVEL_OUTPUTPORT_H_
+
+#include <prim/prim.h>
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "architecture/CreditWatcher.h"
+#include "event/Component.h"
+#include "types/Packet.h"
+
+namespace PacketLevel {
+
+class InputQueue;
+class Router;
+
+/*
+ * This models an output port as a server of whole packets. Requests are
+ *  served in arrival order among those whose VC has enough credits for the
+ *  whole packet, each one no earlier than 'latency' router cycles after it was
+ *  made. Flits depart every 1/(bandwidth * width) channel cycles, or when they
+ *  arrive if the packet is still streaming in, a channel of 'width' flits per
+ *  cycle carries several flits of a packet in one cycle.
+ */
+class OutputPort : public Component {
+ public:
+  OutputPort(const std::string& _name, const Component* _parent,
+             Router* _router, u32 _port, u32 _numVcs, u32 _latency,
+             f64 _bandwidth, CreditWatcher* _creditWatcher,
+             u32 _creditWatcherBase);
+  ~OutputPort();
+
+  // sets the flits per cycle of the output channel
+  void setWidth(u32 _width);
+
+  // credits of the downstream VCs
+  void initCredits(u32 _vc, u32 _credits);
+  void incrementCredits(u32 _vc, u32 _credits);
+
+  // called by the router when an input queue's front packet is routed here
+  void request(InputQueue* _inputQueue, Packet* _packet, u32 _vc);
+
+  // called by the input queue being served when a flit arrives
+  void flitArrived();
+
+  // event system (Component)
+  void processEvent(void* _event, s32 _type) override;
+
+ private:
+  struct Request {
+    InputQueue* inputQueue;
+    Packet* packet;
+    u32 vc;
+    u64 readyTime;
+  };
+
+  void setEvent(u64 _time);
+  void process();
+  // the channel cycle of the first flit slot at or after 'nextDeparture_'
+  u64 departureCycle() const;
+
+  Router* router_;
+  const u32 port_;
+  const u32 numVcs_;
+  const u32 latency_;
+  const f64 bandwidth_;
+  u32 width_;
+  f64 interval_;  // channel cycles per flit
+  CreditWatcher* creditWatcher_;
+  const u32 creditWatcherBase_;
+
+  std::vector<u32> credits_;
+  std::vector<u32> maxCredits_;
+  std::list<Request> requests_;
+
+  // the packet being transmitted
+  Request current_;
+  bool busy_;
+  bool stalled_;  // waiting on a flit to arrive
+  u32 nextFlit_;
+  f64 nextDeparture_;  // channel cycle the output is free for the next flit
+
+  u64 eventTime_;
+};
+
+}  // namespace PacketLevel
+
+#endif  // ROUTER_PACKETLEVEL_OUTPUTPORT_H_
@@ -0,0 +1,271 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "router/packetlevel/Router.h"
+
+#include <factory/ObjectFactory.h>
+
+#include <cassert>
+#include <algorithm>
+
+#include "architecture/util.h"
+#include "network/Network.h"
+#include "router/packetlevel/InputQueue.h"
+#include "router/packetlevel/OutputPort.h"
+#include "types/Packet.h"
+
+namespace PacketLevel {
+
+Router::Router(
+    const std::string& _name, const Component* _parent, Network* _network,
+    u32 _id, const std::vector<u32>& _address, u32 _numPorts, u32 _numVcs,
+    const std::vector<std::tuple<u32, u32> >& _protocolClassVcs,
+    MetadataHandler* _metadataHandler, Json::Value _settings)
+    : ::Router(_name, _parent, _network, _id, _address, _numPorts, _numVcs,
+               _protocolClassVcs, _metadataHandler, _settings) {
+  // the size of credits depends on the input queue depths
+  creditSize_ = 0;
+
+  // queue depths
+  inputQueueDepth_ = 0;
+  inputQueueTailored_ = false;
+  inputQueueMult_ = 0;
+  inputQueueMax_ = 0;
+  inputQueueMin_ = 0;
+  assert(_settings.isMember("input_queue_mode"));
+  if (_settings["input_queue_mode"].asString() == "tailored") {
+    inputQueueTailored_ = true;
+    inputQueueMult_ = _settings["input_queue_depth"].asDouble();
+    assert(inputQueueMult_ > 0.0);
+    // max and min queue depth
+    assert(_settings.isMember("input_queue_min"));
+    inputQueueMin_ = _settings["input_queue_min"].asUInt();
+    assert(_settings.isMember("input_queue_max"));
+    inputQueueMax_ = _settings["input_queue_max"].asUInt();
+    assert(inputQueueMin_ <= inputQueueMax_);
+  } else if (_settings["input_queue_mode"].asString() == "fixed") {
+    inputQueueTailored_ = false;
+    inputQueueDepth_ = _settings["input_queue_depth"].asUInt();
+    assert(inputQueueDepth_ > 0);
+  } else {
+    fprintf(stderr, "Wrong input queue mode, options: tailor or fixed\n");
+    assert(false);
+  }
+
+  // output port servers
+  assert(_settings.isMember("latency") && _settings["latency"].isUInt());
+  u32 latency = _settings["latency"].asUInt();
+  assert(latency > 0);
+  assert(_settings.isMember("bandwidth") && _settings["bandwidth"].isDouble());
+  f64 bandwidth = _settings["bandwidth"].asDouble();
+  assert((bandwidth > 0.0) && (bandwidth <= 1.0));
+
+  // create a congestion status device, it watches the downstream credits
+  congestionSensor_ = CongestionSensor::create(
+      "CongestionSensor", this, this, _settings["congestion_sensor"]);
+
+  // create routing algorithms and input queues
+  routingAlgorithms_.resize(numPorts_ * numVcs_, nullptr);
+  inputQueues_.resize(numPorts_ * numVcs_, nullptr);
+  for (u32 port = 0; port < numPorts_; port++) {
+    for (u32 vc = 0; vc < numVcs_; vc++) {
+      u32 vcIdx = vcIndex(port, vc);
+
+      // create the name suffix
+      std::string nameSuffix = "_" + std::to_string(port) + "_" +
+                               std::to_string(vc);
+
+      // routing algorithm
+      std::string rfname = "RoutingAlgorithm" + nameSuffix;
+      RoutingAlgorithm* rf = network_->createRoutingAlgorithm(
+          port, vc, rfname, this, this);
+      routingAlgorithms_.at(vcIdx) = rf;
+
+      // input queue
+      std::string iqName = "InputQueue" + nameSuffix;
+      inputQueues_.at(vcIdx) = new InputQueue(iqName, this, this, port, vc,
+                                              rf);
+    }
+  }
+
+  // create the output ports
+  outputPorts_.resize(numPorts_, nullptr);
+  for (u32 port = 0; port < numPorts_; port++) {
+    std::string opName = "OutputPort_" + std::to_string(port);
+    outputPorts_.at(port) = new OutputPort(
+        opName, this, this, port, numVcs_, latency, bandwidth,
+        congestionSensor_, vcIndex(port, 0));
+  }
+
+  // allocate slots for I/O channels
+  inputChannels_.resize(numPorts_, nullptr);
+  outputChannels_.resize(numPorts_, nullptr);
+}
+
+Router::~Router() {
+  delete congestionSensor_;
+  for (u32 vc = 0; vc < (numPorts_ * numVcs_); vc++) {
+    delete routingAlgorithms_.at(vc);
+    delete inputQueues_.at(vc);
+  }
+  for (u32 port = 0; port < numPorts_; port++) {
+    delete outputPorts_.at(port);
+  }
+}
+
+void Router::setInputChannel(u32 _port, Channel* _channel) {
+  assert(inputChannels_.at(_port) == nullptr);
+  inputChannels_.at(_port) = _channel;
+  _channel->setSink(this, _port);
+}
+
+Channel* Router::getInputChannel(u32 _port) const {
+  return inputChannels_.at(_port);
+}
+
+void Router::setOutputChannel(u32 _port, Channel* _channel) {
+  assert(outputChannels_.at(_port) == nullptr);
+  outputChannels_.at(_port) = _channel;
+  _channel->setSource(this, _port);
+}
+
+Channel* Router::getOutputChannel(u32 _port) const {
+  return outputChannels_.at(_port);
+}
+
+void Router::initialize() {
+  // set input queue depth
+  u32 maxDepth = 0;
+  for (u32 port = 0; port < numPorts_; port++) {
+    u32 queueDepth = inputQueueDepth_;
+    if (inputQueueTailored_) {
+      if (inputChannels_.at(port)) {
+        u32 channelLatency = inputChannels_.at(port)->latency();
+        queueDepth = computeTailoredBufferLength(
+            inputQueueMult_, inputQueueMin_, inputQueueMax_, channelLatency);
+      } else {
+        // if no channel, make no queuing and inf credits
+        queueDepth = 0;
+      }
+    }
+    for (u32 vc = 0; vc < numVcs_; vc++) {
+      inputQueues_.at(vcIndex(port, vc))->setDepth(queueDepth);
+    }
+    maxDepth = std::max(maxDepth, queueDepth);
+  }
+
+  // each VC returns at most one packet of credits per cycle and a packet fits
+  //  in the input queue
+  creditSize_ = numVcs_ * maxDepth;
+
+  // wide output channels carry several flits per cycle
+  for (u32 port = 0; port < numPorts_; port++) {
+    if (outputChannels_.at(port)) {
+      outputPorts_.at(port)->setWidth(outputChannels_.at(port)->width());
+    }
+  }
+
+  // init credits
+  for (u32 port = 0; port < numPorts_; port++) {
+    // donwstream queue depth
+    u32 credits = inputQueueDepth_;
+    if (inputQueueTailored_) {
+      if (outputChannels_.at(port)) {
+        u32 channelLatency = outputChannels_.at(port)->latency();
+        credits = computeTailoredBufferLength(
+            inputQueueMult_, inputQueueMin_, inputQueueMax_, channelLatency);
+      } else {
+        // if no channel, make no queuing and inf credits
+        credits = U32_MAX;
+      }
+    }
+    for (u32 vc = 0; vc < numVcs_; vc++) {
+      outputPorts_.at(port)->initCredits(vc, credits);
+    }
+  }
+}
+
+void Router::receiveFlit(u32 _port, Flit* _flit) {
+  u32 vc = _flit->getVc();
+  inputQueues_.at(vcIndex(_port, vc))->receiveFlit(_flit);
+
+  // inform base class of arrival
+  if (_flit->isHead()) {
+    packetArrival(_port, _flit->packet());
+  }
+}
+
+void Router::receiveCredit(u32 _port, Credit* _credit) {
+  // a packet's credits arrive together, hand them over in one step
+  u32 vc = U32_MAX;
+  u32 credits = 0;
+  while (_credit->more()) {
+    u32 next = _credit->getNum();
+    if ((next != vc) && (credits > 0)) {
+      outputPorts_.at(_port)->incrementCredits(vc, credits);
+      credits = 0;
+    }
+    vc = next;
+    credits++;
+  }
+  if (credits > 0) {
+    outputPorts_.at(_port)->incrementCredits(vc, credits);
+  }
+  delete _credit;
+}
+
+void Router::sendCredit(u32 _port, u32 _vc) {
+  sendCredits(_port, _vc, 1);
+}
+
+void Router::sendFlit(u32 _port, Flit* _flit) {
+  assert(!outputChannels_.at(_port)->isNextFlitSlotFull());
+  outputChannels_.at(_port)->setNextFlit(_flit);
+
+  // inform base class of departure
+  if (_flit->isHead()) {
+    packetDeparture(_port, _flit->packet());
+  }
+}
+
+void Router::sendCredits(u32 _port, u32 _vc, u32 _credits) {
+  // ensure there is an outgoing credit for the next time slot
+  assert(_vc < numVcs_);
+  Credit* credit = inputChannels_.at(_port)->getNextCredit();
+  if (credit == nullptr) {
+    credit = new Credit(creditSize_);
+    inputChannels_.at(_port)->setNextCredit(credit);
+  }
+
+  // mark the credit with the specified VC once per flit
+  for (u32 c = 0; c < _credits; c++) {
+    credit->putNum(_vc);
+  }
+}
+
+f64 Router::congestionStatus(u32 _inputPort, u32 _inputVc,
+                             u32 _outputPort, u32 _outputVc) const {
+  return congestionSensor_->status(_inputPort, _inputVc, _outputPort,
+                                   _outputVc);
+}
+
+void Router::requestOutput(InputQueue* _inputQueue, Packet* _packet,
+                           u32 _outputPort, u32 _outputVc) {
+  outputPorts_.at(_outputPort)->request(_inputQueue, _packet, _outputVc);
+}
+
+}  // namespace PacketLevel
+
+registerWithObjectFactory("packet_level", ::Router,
+                          PacketLevel::Router, ROUTER_ARGS);
@@ -0,0 +1,103 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROUTER_PACKETLEVEL_ROUTER_H_
+#define ROUTER_PACKETLEVEL_ROUTER_H_
+
+#include <json/json.h>
+#include <prim/prim.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "congestion/CongestionSensor.h"
+#include "event/Component.h"
+#include "network/Channel.h"
+#include "routing/RoutingAlgorithm.h"
+#include "router/Router.h"
+#include "types/Credit.h"
+#include "types/Flit.h"
+
+class Network;
+
+namespace PacketLevel {
+
+class InputQueue;
+class OutputPort;
+
+/*
+ * This router is an abstract model meant for very large scale studies. It
+ *  doesn't model any internal pipeline at flit granularity. Each input VC is
+ *  a FIFO of packets where only the front packet is routed and served. Each
+ *  output port is a server that transmits one packet at a time after a fixed
+ *  latency, at a configurable fraction of the channel bandwidth. A packet only
+ *  starts when the downstream VC has credits for the whole packet (virtual
+ *  cut-through), so the downstream buffer must hold the largest packet. The
+ *  credits of a packet go back upstream in one bundle when its tail departs.
+ */
+class Router : public ::Router {
+ public:
+  Router(const std::string& _name, const Component* _parent, Network* _network,
+         u32 _id, const std::vector<u32>& _address, u32 _numPorts, u32 _numVcs,
+         const std::vector<std::tuple<u32, u32> >& _protocolClassVcs,
+         MetadataHandler* _metadataHandler, Json::Value _settings);
+  ~Router();
+
+  // Network
+  void setInputChannel(u32 _port, Channel* _channel) override;
+  Channel* getInputChannel(u32 _port) const override;
+  void setOutputChannel(u32 _port, Channel* _channel) override;
+  Channel* getOutputChannel(u32 _port) const override;
+
+  // override to initialize credits
+  void initialize() override;
+
+  void receiveFlit(u32 _port, Flit* _flit) override;
+  void receiveCredit(u32 _port, Credit* _credit) override;
+
+  void sendCredit(u32 _port, u32 _vc) override;
+  void sendFlit(u32 _port, Flit* _flit) override;
+
+  // called by an input queue when the tail of its front packet departs
+  void sendCredits(u32 _port, u32 _vc, u32 _credits);
+
+  f64 congestionStatus(u32 _inputPort, u32 _inputVc, u32 _outputPort,
+                       u32 _outputVc) const override;
+
+  // called by an input queue once its front packet is routed (epsilon 0)
+  void requestOutput(InputQueue* _inputQueue, Packet* _packet, u32 _outputPort,
+                     u32 _outputVc);
+
+ private:
+  u32 creditSize_;
+
+  u32 inputQueueDepth_;
+  bool inputQueueTailored_;
+  f64 inputQueueMult_;
+  u32 inputQueueMax_;
+  u32 inputQueueMin_;
+
+  std::vector<RoutingAlgorithm*> routingAlgorithms_;
+  std::vector<InputQueue*> inputQueues_;
+  std::vector<OutputPort*> outputPorts_;
+  CongestionSensor* congestionSensor_;
+
+  std::vector<Channel*> inputChannels_;
+  std::vector<Channel*> outputChannels_;
+};
+
+}  // namespace PacketLevel
+
+#endif  // ROUTER_PACKETLEVEL_ROUTER_H_
@@ -103,6 +103,15 @@ void RoutingAlgorithm::request(Client* _client, Flit* _flit,
   addEvent(respTime, 0, evt, 0);
 }
 
+bool RoutingAlgorithm::supportsLookahead() const {
+  return false;
+}
+
+void RoutingAlgorithm::lookahead(Flit* _flit, Response* _response) {
+  assert(supportsLookahead());
+  processRequest(_flit, _response);
+}
+
 void RoutingAlgorithm::vcScheduled(Flit* _flit, u32 _port, u32 _vc) {}
 
 void RoutingAlgorithm::processEvent(void* _event, s32 _type) {
@@ -82,6 +82,12 @@ class RoutingAlgorithm : public Component {
   u32 inputPort() const;
   u32 inputVc() const;
   void request(Client* _client, Flit* _flit, Response* _response);
+
+  // lookahead routing computes the response immediately, on behalf of the
+  //  upstream router. only algorithms that can make their decision before the
+  //  flit arrives support this.
+  virtual bool supportsLookahead() const;
+  void lookahead(Flit* _flit, Response* _response);
   virtual void vcScheduled(Flit* _flit, u32 _port, u32 _vc);
   void processEvent(void* _event, s32 _type) override;
 
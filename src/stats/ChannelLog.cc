@@ -16,8 +16,12 @@
 
 #include <cassert>
 
+#include <string>
+#include <vector>
+
 ChannelLog::ChannelLog(u32 _numVcs, Json::Value _settings)
-    : numVcs_(_numVcs), outFile_(nullptr) {
+    : numVcs_(_numVcs), outFile_(nullptr), window_(0), windowFile_(nullptr),
+      namesFile_(nullptr), numChannels_(0) {
   if (!_settings["file"].isNull()) {
     // create file
     outFile_ = new fio::OutFile(_settings["file"].asString());
@@ -38,12 +42,34 @@ ChannelLog::ChannelLog(u32 _numVcs, Json::Value _settings)
     ss_.str("");
     ss_.clear();
   }
+
+  assert(_settings.isMember("window_file"));
+  if (!_settings["window_file"].isNull()) {
+    assert(_settings.isMember("window") && _settings["window"].isUInt());
+    window_ = _settings["window"].asUInt();
+    assert(window_ > 0);
+    assert(_settings.isMember("window_names_file") &&
+           _settings["window_names_file"].isString());
+
+    // create files, the matrix header is written with the first channel
+    windowFile_ = new fio::OutFile(_settings["window_file"].asString());
+    namesFile_ = new fio::OutFile(_settings["window_names_file"].asString());
+    namesFile_->write("index,name\n");
+  }
 }
 
 ChannelLog::~ChannelLog() {
   if (outFile_) {
     delete outFile_;
   }
+  if (windowFile_) {
+    delete windowFile_;
+    delete namesFile_;
+  }
+}
+
+u32 ChannelLog::window() const {
+  return window_;
 }
 
 void ChannelLog::logChannel(const Channel* _channel) {
@@ -60,4 +86,33 @@ void ChannelLog::logChannel(const Channel* _channel) {
     ss_.str("");
     ss_.clear();
   }
+  if (windowFile_) {
+    logWindows(_channel);
+  }
+}
+
+void ChannelLog::logWindows(const Channel* _channel) {
+  const std::vector<u32>& counts = _channel->windowCounts();
+  u32 index = numChannels_++;
+
+  // the first channel determines the number of windows
+  if (index == 0) {
+    std::string header = "index";
+    for (u32 w = 0; w < counts.size(); w++) {
+      header += ',' + std::to_string(w);
+    }
+    header += '\n';
+    windowFile_->write(header);
+  }
+
+  // write the counts of the channel as a row of the matrix
+  std::string row = std::to_string(index);
+  for (u32 count : counts) {
+    row += ',' + std::to_string(count);
+  }
+  row += '\n';
+  windowFile_->write(row);
+
+  // name the channel
+  namesFile_->write(std::to_string(index) + ',' + _channel->fullName() + '\n');
 }
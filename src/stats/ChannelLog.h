@@ -23,16 +23,30 @@
 
 #include "network/Channel.h"
 
+/*
+ * This logs the utilization of each channel over the monitoring period. If a
+ *  'window_file' is given it also logs the flit counts of each channel in
+ *  windows of 'window' channel cycles as a matrix with a row per channel, the
+ *  channels are identified by index and named in the 'window_names_file'.
+ */
 class ChannelLog {
  public:
   explicit ChannelLog(u32 _numVcs, Json::Value _settings);
   ~ChannelLog();
+  u32 window() const;  // 0 when windowed counts are disabled
   void logChannel(const Channel* _channel);
 
  private:
+  void logWindows(const Channel* _channel);
+
   const u32 numVcs_;
   fio::OutFile* outFile_;
   std::stringstream ss_;
+
+  u32 window_;
+  fio::OutFile* windowFile_;
+  fio::OutFile* namesFile_;
+  u32 numChannels_;
 };
 
 #endif  // STATS_CHANNELLOG_H_
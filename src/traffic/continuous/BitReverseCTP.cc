@@ -34,5 +34,5 @@ u32 BitReverseCTP::nextDestination() {
   return dest_;
 }
 
-registerWithObjectFactory("BitReverse", ContinuousTrafficPattern,
+registerWithObjectFactory("bit_reverse", ContinuousTrafficPattern,
                           BitReverseCTP, CONTINUOUSTRAFFICPATTERN_ARGS);
@@ -71,3 +71,20 @@ u64 Flit::getReceiveTime() const {
   assert(receiveTime_ != U64_MAX);
   return receiveTime_;
 }
+
+bool Flit::hasLookahead() const {
+  return !lookahead_.empty();
+}
+
+const std::vector<std::pair<u32, u32> >& Flit::getLookahead() const {
+  return lookahead_;
+}
+
+void Flit::addLookahead(u32 _port, u32 _vc) {
+  assert(head_);
+  lookahead_.push_back({_port, _vc});
+}
+
+void Flit::clearLookahead() {
+  lookahead_.clear();
+}
@@ -17,6 +17,9 @@
 
 #include <prim/prim.h>
 
+#include <utility>
+#include <vector>
+
 class Packet;
 
 class Flit {
@@ -38,6 +41,12 @@ class Flit {
   void setReceiveTime(u64 time);
   u64 getReceiveTime() const;
 
+  // lookahead routing, (port, vc) options of the next router (head flit only)
+  bool hasLookahead() const;
+  const std::vector<std::pair<u32, u32> >& getLookahead() const;
+  void addLookahead(u32 _port, u32 _vc);
+  void clearLookahead();
+
  private:
   u32 id_;
   bool head_;
@@ -47,6 +56,8 @@ class Flit {
 
   u64 sendTime_;
   u64 receiveTime_;
+
+  std::vector<std::pair<u32, u32> > lookahead_;
 };
 
 #endif  // TYPES_FLIT_H_
@@ -0,0 +1,156 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/BitMatrix.h"
+
+#include <cassert>
+
+BitMatrix::BitMatrix()
+    : rows_(0), cols_(0), rowWords_(0) {}
+
+BitMatrix::BitMatrix(u32 _rows, u32 _cols)
+    : BitMatrix() {
+  resize(_rows, _cols);
+}
+
+BitMatrix::~BitMatrix() {}
+
+void BitMatrix::resize(u32 _rows, u32 _cols) {
+  rows_ = _rows;
+  cols_ = _cols;
+  rowWords_ = wordsFor(cols_);
+  words_.clear();
+  words_.resize((u64)rows_ * rowWords_, 0);
+}
+
+u32 BitMatrix::rows() const {
+  return rows_;
+}
+
+u32 BitMatrix::cols() const {
+  return cols_;
+}
+
+u32 BitMatrix::rowWords() const {
+  return rowWords_;
+}
+
+u64* BitMatrix::row(u32 _row) {
+  assert(_row < rows_);
+  return &words_[(u64)_row * rowWords_];
+}
+
+const u64* BitMatrix::row(u32 _row) const {
+  assert(_row < rows_);
+  return &words_[(u64)_row * rowWords_];
+}
+
+bool BitMatrix::test(u32 _row, u32 _col) const {
+  assert(_col < cols_);
+  return (row(_row)[_col / 64] >> (_col % 64)) & 0x1;
+}
+
+void BitMatrix::set(u32 _row, u32 _col) {
+  assert(_col < cols_);
+  row(_row)[_col / 64] |= (u64)1 << (_col % 64);
+}
+
+void BitMatrix::clear(u32 _row, u32 _col) {
+  assert(_col < cols_);
+  row(_row)[_col / 64] &= ~((u64)1 << (_col % 64));
+}
+
+void BitMatrix::clear() {
+  for (u64 w = 0; w < words_.size(); w++) {
+    words_[w] = 0;
+  }
+}
+
+void BitMatrix::clearRow(u32 _row) {
+  u64* words = row(_row);
+  for (u32 w = 0; w < rowWords_; w++) {
+    words[w] = 0;
+  }
+}
+
+void BitMatrix::clearColumn(u32 _col) {
+  assert(_col < cols_);
+  u64 mask = ~((u64)1 << (_col % 64));
+  for (u64 w = _col / 64; w < words_.size(); w += rowWords_) {
+    words_[w] &= mask;
+  }
+}
+
+bool BitMatrix::any() const {
+  u64 accum = 0;
+  for (u64 w = 0; w < words_.size(); w++) {
+    accum |= words_[w];
+  }
+  return accum != 0;
+}
+
+bool BitMatrix::rowAny(u32 _row) const {
+  const u64* words = row(_row);
+  u64 accum = 0;
+  for (u32 w = 0; w < rowWords_; w++) {
+    accum |= words[w];
+  }
+  return accum != 0;
+}
+
+u32 BitMatrix::rowCount(u32 _row) const {
+  const u64* words = row(_row);
+  u32 count = 0;
+  for (u32 w = 0; w < rowWords_; w++) {
+    count += __builtin_popcountll(words[w]);
+  }
+  return count;
+}
+
+u32 BitMatrix::rowNext(u32 _row, u32 _start) const {
+  assert(_start < cols_);
+  const u64* words = row(_row);
+
+  // search from the start position to the end of the row, the first word
+  //  has the bits below the start position masked off
+  u32 first = _start / 64;
+  u64 word = words[first] & (U64_MAX << (_start % 64));
+  for (u32 w = first; ; ) {
+    if (word != 0) {
+      return (w * 64) + __builtin_ctzll(word);
+    }
+    w++;
+    if (w == rowWords_) {
+      break;
+    }
+    word = words[w];
+  }
+
+  // wrap around and search up to and including the start word, only the bits
+  //  below the start position remain to be checked in the start word
+  for (u32 w = 0; w <= first; w++) {
+    word = words[w];
+    if (w == first) {
+      word &= ~(U64_MAX << (_start % 64));
+    }
+    if (word != 0) {
+      return (w * 64) + __builtin_ctzll(word);
+    }
+  }
+  return U32_MAX;
+}
+
+u32 BitMatrix::wordsFor(u32 _bits) {
+  return (_bits + 63) / 64;
+}
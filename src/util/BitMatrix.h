@@ -0,0 +1,72 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef UTIL_BITMATRIX_H_
+#define UTIL_BITMATRIX_H_
+
+#include <prim/prim.h>
+
+#include <vector>
+
+/*
+ * This class is a dense matrix of bits where each row is packed into 64-bit
+ *  words. Rows are contiguous and padded to a whole number of words, so row
+ *  operations (clearing, testing, searching) are performed a word at a time.
+ *  Padding bits beyond the column count are always zero.
+ */
+class BitMatrix {
+ public:
+  BitMatrix();
+  BitMatrix(u32 _rows, u32 _cols);
+  ~BitMatrix();
+
+  // Warning: this clears all data
+  void resize(u32 _rows, u32 _cols);
+
+  u32 rows() const;
+  u32 cols() const;
+  u32 rowWords() const;
+
+  // direct access to the packed words of a row
+  u64* row(u32 _row);
+  const u64* row(u32 _row) const;
+
+  // single bit access
+  bool test(u32 _row, u32 _col) const;
+  void set(u32 _row, u32 _col);
+  void clear(u32 _row, u32 _col);
+
+  // bulk operations
+  void clear();
+  void clearRow(u32 _row);
+  void clearColumn(u32 _col);
+  bool any() const;
+  bool rowAny(u32 _row) const;
+  u32 rowCount(u32 _row) const;
+
+  // returns the first set column in the row at or after '_start', wrapping
+  //  around to the beginning of the row, or U32_MAX if the row is empty
+  u32 rowNext(u32 _row, u32 _start) const;
+
+  // returns the number of 64-bit words needed to hold '_bits' bits
+  static u32 wordsFor(u32 _bits);
+
+ private:
+  u32 rows_;
+  u32 cols_;
+  u32 rowWords_;
+  std::vector<u64> words_;
+};
+
+#endif  // UTIL_BITMATRIX_H_
@@ -0,0 +1,89 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "util/BitMatrix.h"
+
+#include <gtest/gtest.h>
+#include <prim/prim.h>
+
+#include <vector>
+
+TEST(BitMatrix, setClear) {
+  for (u32 cols = 1; cols < 200; cols += 7) {
+    BitMatrix bm(5, cols);
+    ASSERT_EQ(bm.rows(), 5u);
+    ASSERT_EQ(bm.cols(), cols);
+    ASSERT_EQ(bm.rowWords(), (cols + 63) / 64);
+    ASSERT_FALSE(bm.any());
+
+    for (u32 c = 0; c < cols; c += 3) {
+      bm.set(2, c);
+    }
+    ASSERT_TRUE(bm.any());
+    ASSERT_FALSE(bm.rowAny(1));
+    ASSERT_TRUE(bm.rowAny(2));
+    ASSERT_EQ(bm.rowCount(2), (cols + 2) / 3);
+    for (u32 c = 0; c < cols; c++) {
+      ASSERT_EQ(bm.test(2, c), (c % 3) == 0);
+      ASSERT_FALSE(bm.test(3, c));
+    }
+
+    bm.clear(2, 0);
+    ASSERT_FALSE(bm.test(2, 0));
+    bm.clearRow(2);
+    ASSERT_FALSE(bm.any());
+  }
+}
+
+TEST(BitMatrix, clearColumn) {
+  BitMatrix bm(10, 130);
+  for (u32 r = 0; r < 10; r++) {
+    for (u32 c = 0; c < 130; c++) {
+      bm.set(r, c);
+    }
+  }
+  bm.clearColumn(64);
+  bm.clearColumn(129);
+  for (u32 r = 0; r < 10; r++) {
+    ASSERT_EQ(bm.rowCount(r), 128u);
+    ASSERT_FALSE(bm.test(r, 64));
+    ASSERT_FALSE(bm.test(r, 129));
+    ASSERT_TRUE(bm.test(r, 128));
+  }
+}
+
+TEST(BitMatrix, rowNext) {
+  for (u32 cols = 1; cols < 300; cols += 11) {
+    BitMatrix bm(1, cols);
+    for (u32 start = 0; start < cols; start++) {
+      ASSERT_EQ(bm.rowNext(0, start), U32_MAX);
+    }
+
+    std::vector<u32> set = {cols / 2, cols - 1};
+    for (u32 s : set) {
+      bm.set(0, s);
+    }
+    for (u32 start = 0; start < cols; start++) {
+      // brute force the expected answer
+      u32 exp = U32_MAX;
+      for (u32 idx = start; idx < start + cols; idx++) {
+        if (bm.test(0, idx % cols)) {
+          exp = idx % cols;
+          break;
+        }
+      }
+      ASSERT_EQ(bm.rowNext(0, start), exp);
+    }
+  }
+}
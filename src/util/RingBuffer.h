@@ -0,0 +1,54 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef UTIL_RINGBUFFER_H_
+#define UTIL_RINGBUFFER_H_
+
+#include <prim/prim.h>
+
+#include <vector>
+
+/*
+ * This class is a FIFO queue stored in a circular array. The storage only
+ *  grows (doubling) when a push finds it full, so a queue that reaches its
+ *  steady state size performs no further memory allocation.
+ */
+template <typename T>
+class RingBuffer {
+ public:
+  explicit RingBuffer(u32 _capacity = 4);
+  ~RingBuffer();
+
+  u32 size() const;
+  bool empty() const;
+  u32 capacity() const;
+
+  T& front();
+  const T& front() const;
+  T& back();
+  const T& back() const;
+  void push(const T& _element);
+  void pop();
+
+ private:
+  void grow();
+
+  std::vector<T> elements_;
+  u32 head_;
+  u32 size_;
+};
+
+#include "util/RingBuffer.tcc"
+
+#endif  // UTIL_RINGBUFFER_H_
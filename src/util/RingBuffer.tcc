@@ -0,0 +1,99 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cassert>
+
+#include <vector>
+
+template <typename T>
+RingBuffer<T>::RingBuffer(u32 _capacity)
+    : elements_(_capacity), head_(0), size_(0) {
+  assert(_capacity > 0);
+}
+
+template <typename T>
+RingBuffer<T>::~RingBuffer() {}
+
+template <typename T>
+u32 RingBuffer<T>::size() const {
+  return size_;
+}
+
+template <typename T>
+bool RingBuffer<T>::empty() const {
+  return size_ == 0;
+}
+
+template <typename T>
+u32 RingBuffer<T>::capacity() const {
+  return elements_.size();
+}
+
+template <typename T>
+T& RingBuffer<T>::front() {
+  assert(size_ > 0);
+  return elements_[head_];
+}
+
+template <typename T>
+const T& RingBuffer<T>::front() const {
+  assert(size_ > 0);
+  return elements_[head_];
+}
+
+template <typename T>
+T& RingBuffer<T>::back() {
+  assert(size_ > 0);
+  return elements_[(head_ + size_ - 1) % elements_.size()];
+}
+
+template <typename T>
+const T& RingBuffer<T>::back() const {
+  assert(size_ > 0);
+  return elements_[(head_ + size_ - 1) % elements_.size()];
+}
+
+template <typename T>
+void RingBuffer<T>::push(const T& _element) {
+  if (size_ == elements_.size()) {
+    grow();
+  }
+  u32 tail = head_ + size_;
+  if (tail >= elements_.size()) {
+    tail -= elements_.size();
+  }
+  elements_[tail] = _element;
+  size_++;
+}
+
+template <typename T>
+void RingBuffer<T>::pop() {
+  assert(size_ > 0);
+  head_++;
+  if (head_ == elements_.size()) {
+    head_ = 0;
+  }
+  size_--;
+}
+
+template <typename T>
+void RingBuffer<T>::grow() {
+  // unroll the elements into a larger array starting at index 0
+  std::vector<T> elements(elements_.size() * 2);
+  for (u32 i = 0; i < size_; i++) {
+    elements[i] = elements_[(head_ + i) % elements_.size()];
+  }
+  elements_.swap(elements);
+  head_ = 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * Licensed under the Apache License, Version 2.0 (the 'License');
+ * you may not use this file except in compliance with the License.
+ * See the NOTICE file distributed with this work for additional information
+ * regarding copyright ownership. You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <prim/prim.h>
+
+#include "util/RingBuffer.h"
+
+#include "gtest/gtest.h"
+
+TEST(RingBuffer, fifo) {
+  RingBuffer<u32> rb(4);
+  ASSERT_TRUE(rb.empty());
+  ASSERT_EQ(rb.capacity(), 4u);
+
+  // walk the head around the array several times without growing
+  u32 next = 0;
+  u32 expected = 0;
+  for (u32 round = 0; round < 10; round++) {
+    for (u32 i = 0; i < 3; i++) {
+      rb.push(next++);
+      ASSERT_EQ(rb.back(), next - 1);
+    }
+    ASSERT_EQ(rb.size(), 3u);
+    for (u32 i = 0; i < 3; i++) {
+      ASSERT_EQ(rb.front(), expected++);
+      rb.pop();
+    }
+    ASSERT_TRUE(rb.empty());
+  }
+  ASSERT_EQ(rb.capacity(), 4u);
+}
+
+TEST(RingBuffer, grow) {
+  RingBuffer<u32> rb(2);
+
+  // offset the head so the growth must unwrap the elements
+  rb.push(100);
+  rb.pop();
+  for (u32 i = 0; i < 9; i++) {
+    rb.push(i);
+  }
+  ASSERT_EQ(rb.size(), 9u);
+  ASSERT_EQ(rb.capacity(), 16u);
+  for (u32 i = 0; i < 9; i++) {
+    ASSERT_EQ(rb.front(), i);
+    rb.pop();
+  }
+  ASSERT_TRUE(rb.empty());
+}